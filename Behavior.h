@@ -0,0 +1,418 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class BehaviorScheduler;
+
+//  .      BehaviorScheduler::Spawn,
+//    .
+class BehaviorTask {
+public:
+    struct promise_type {
+        BehaviorScheduler* scheduler = nullptr;
+        int taskIndex = -1;
+
+        BehaviorTask get_return_object() {
+            return BehaviorTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+
+        //      
+        static void* operator new(size_t size) {
+            frameBytes.fetch_add(size, std::memory_order_relaxed);
+            return ::operator new(size);
+        }
+        static void operator delete(void* pointer, size_t size) {
+            frameBytes.fetch_sub(size, std::memory_order_relaxed);
+            ::operator delete(pointer);
+        }
+    };
+
+    inline static std::atomic<size_t> frameBytes{ 0 };
+
+    BehaviorTask(BehaviorTask&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    BehaviorTask(const BehaviorTask&) = delete;
+    BehaviorTask& operator=(const BehaviorTask&) = delete;
+
+    ~BehaviorTask() {
+        if (handle) handle.destroy();
+    }
+
+    std::coroutine_handle<promise_type> Release() {
+        return std::exchange(handle, nullptr);
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+    explicit BehaviorTask(std::coroutine_handle<promise_type> taskHandle) : handle(taskHandle) {}
+};
+
+//  :      
+//   .     ,
+//           .
+class BehaviorScheduler {
+public:
+    static const int WHEEL_BITS = 8;
+    static const int WHEEL_SIZE = 1 << WHEEL_BITS;
+    float TICK_SECONDS = 0.01f;      //  
+    float WATCH_CELL_SIZE = 256.0f;  //     
+
+    BehaviorScheduler() {
+        currentTick = 0;
+        accumulator = 0.0f;
+        freeList = -1;
+        maxWatchRadius = 0.0f;
+        resumedLastTick = 0;
+        liveTasks = 0;
+        for (auto& slot : nearWheel) slot = -1;
+        for (auto& slot : farWheel) slot = -1;
+        overflow = -1;
+    }
+
+    ~BehaviorScheduler() {
+        Clear();
+    }
+
+    BehaviorScheduler(const BehaviorScheduler&) = delete;
+    BehaviorScheduler& operator=(const BehaviorScheduler&) = delete;
+
+    //      Tick
+    int Spawn(BehaviorTask task) {
+        auto handle = task.Release();
+        int index = AllocateTask();
+        tasks[index].handle = handle;
+        handle.promise().scheduler = this;
+        handle.promise().taskIndex = index;
+        ready.push_back(index);
+        liveTasks++;
+        return index;
+    }
+
+    //   ,    
+    void Clear() {
+        for (int i = 0; i < static_cast<int>(tasks.size()); i++) {
+            if (tasks[i].handle) tasks[i].handle.destroy();
+        }
+        tasks.clear();
+        ready.clear();
+        watchCells.clear();
+        freeList = -1;
+        overflow = -1;
+        for (auto& slot : nearWheel) slot = -1;
+        for (auto& slot : farWheel) slot = -1;
+        liveTasks = 0;
+        maxWatchRadius = 0.0f;
+    }
+
+    // targets - ,     ()
+    void Tick(float deltaTime, const std::vector<SDL_FPoint>& currentTargets) {
+        targets = currentTargets;
+        resumedLastTick = 0;
+
+        accumulator += deltaTime;
+        while (accumulator >= TICK_SECONDS) {
+            accumulator -= TICK_SECONDS;
+            AdvanceWheel();
+        }
+        WakeWatchers();
+
+        // ,    ,   
+        running.swap(ready);
+        for (int index : running) {
+            auto handle = tasks[index].handle;
+            handle.resume();
+            resumedLastTick++;
+            if (handle.done()) {
+                handle.destroy();
+                FreeTask(index);
+            }
+        }
+        running.clear();
+    }
+
+    double Now() const {
+        return currentTick * static_cast<double>(TICK_SECONDS) + accumulator;
+    }
+
+    const std::vector<SDL_FPoint>& Targets() const {
+        return targets;
+    }
+
+    //    ; false,   
+    bool NearestTarget(float x, float y, SDL_FPoint& nearest, float& distanceSquared) const {
+        bool found = false;
+        for (const SDL_FPoint& target : targets) {
+            float dx = target.x - x;
+            float dy = target.y - y;
+            float distance = dx * dx + dy * dy;
+            if (!found || distance < distanceSquared) {
+                nearest = target;
+                distanceSquared = distance;
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    size_t TaskCount() const {
+        return liveTasks;
+    }
+
+    size_t ResumedLastTick() const {
+        return resumedLastTick;
+    }
+
+    //      (  BehaviorTask::frameBytes)
+    size_t MemoryBytes() const {
+        size_t bytes = sizeof(*this) + tasks.capacity() * sizeof(TaskRecord) +
+            (ready.capacity() + running.capacity()) * sizeof(int);
+        for (const auto& cell : watchCells) {
+            bytes += sizeof(cell) + cell.second.capacity() * sizeof(Watcher);
+        }
+        return bytes;
+    }
+
+    //   awaitable-
+    void ScheduleAfter(int index, float seconds) {
+        uint64_t ticks = static_cast<uint64_t>(std::ceil(seconds / TICK_SECONDS));
+        if (ticks == 0) ticks = 1;
+        tasks[index].wakeTick = currentTick + ticks;
+        InsertTimer(index);
+    }
+
+    void ScheduleNextTick(int index) {
+        ready.push_back(index);
+    }
+
+    void WatchProximity(int index, float x, float y, float radius) {
+        maxWatchRadius = std::max(maxWatchRadius, radius);
+        watchCells[CellKey(CellCoord(x), CellCoord(y))].push_back({ index, x, y, radius * radius });
+    }
+
+private:
+    struct TaskRecord {
+        std::coroutine_handle<BehaviorTask::promise_type> handle;
+        uint64_t wakeTick = 0;
+        int next = -1;  //        
+    };
+
+    struct Watcher {
+        int taskIndex;
+        float x, y;
+        float radiusSquared;
+    };
+
+    std::vector<TaskRecord> tasks;
+    std::vector<int> ready;
+    std::vector<int> running;
+    std::vector<SDL_FPoint> targets;
+    std::unordered_map<int64_t, std::vector<Watcher>> watchCells;
+    int nearWheel[WHEEL_SIZE];   //  
+    int farWheel[WHEEL_SIZE];    //  WHEEL_SIZE 
+    int overflow;                // ,    
+    int freeList;
+    uint64_t currentTick;
+    float accumulator;
+    float maxWatchRadius;
+    size_t resumedLastTick;
+    size_t liveTasks;
+
+    int AllocateTask() {
+        if (freeList >= 0) {
+            int index = freeList;
+            freeList = tasks[index].next;
+            tasks[index].next = -1;
+            return index;
+        }
+        tasks.push_back(TaskRecord());
+        return static_cast<int>(tasks.size()) - 1;
+    }
+
+    void FreeTask(int index) {
+        tasks[index].handle = nullptr;
+        tasks[index].next = freeList;
+        freeList = index;
+        liveTasks--;
+    }
+
+    void InsertTimer(int index) {
+        uint64_t wake = tasks[index].wakeTick;
+        uint64_t delta = wake - currentTick;
+        int* slot;
+        if (delta < WHEEL_SIZE) {
+            slot = &nearWheel[wake & (WHEEL_SIZE - 1)];
+        }
+        else if (delta < static_cast<uint64_t>(WHEEL_SIZE) * WHEEL_SIZE) {
+            slot = &farWheel[(wake >> WHEEL_BITS) & (WHEEL_SIZE - 1)];
+        }
+        else {
+            slot = &overflow;
+        }
+        tasks[index].next = *slot;
+        *slot = index;
+    }
+
+    //      ()
+    void Reinsert(int head) {
+        while (head >= 0) {
+            int next = tasks[head].next;
+            InsertTimer(head);
+            head = next;
+        }
+    }
+
+    void AdvanceWheel() {
+        currentTick++;
+
+        if ((currentTick & (WHEEL_SIZE - 1)) == 0) {
+            uint64_t farIndex = (currentTick >> WHEEL_BITS) & (WHEEL_SIZE - 1);
+            if (farIndex == 0) {
+                int head = overflow;
+                overflow = -1;
+                Reinsert(head);
+            }
+            int head = farWheel[farIndex];
+            farWheel[farIndex] = -1;
+            Reinsert(head);
+        }
+
+        int& slot = nearWheel[currentTick & (WHEEL_SIZE - 1)];
+        int head = slot;
+        slot = -1;
+        while (head >= 0) {
+            int next = tasks[head].next;
+            tasks[head].next = -1;
+            ready.push_back(head);
+            head = next;
+        }
+    }
+
+    //      ,    
+    void WakeWatchers() {
+        if (watchCells.empty()) return;
+
+        int reach = static_cast<int>(std::ceil(maxWatchRadius / WATCH_CELL_SIZE));
+        for (const SDL_FPoint& target : targets) {
+            int targetX = CellCoord(target.x);
+            int targetY = CellCoord(target.y);
+            for (int cy = targetY - reach; cy <= targetY + reach; cy++) {
+                for (int cx = targetX - reach; cx <= targetX + reach; cx++) {
+                    auto cell = watchCells.find(CellKey(cx, cy));
+                    if (cell == watchCells.end()) continue;
+
+                    auto& watchers = cell->second;
+                    for (size_t i = 0; i < watchers.size();) {
+                        float dx = watchers[i].x - target.x;
+                        float dy = watchers[i].y - target.y;
+                        if (dx * dx + dy * dy <= watchers[i].radiusSquared) {
+                            ready.push_back(watchers[i].taskIndex);
+                            watchers[i] = watchers.back();
+                            watchers.pop_back();
+                        }
+                        else {
+                            i++;
+                        }
+                    }
+                    if (watchers.empty()) watchCells.erase(cell);
+                }
+            }
+        }
+    }
+
+    int CellCoord(float value) const {
+        return static_cast<int>(std::floor(value / WATCH_CELL_SIZE));
+    }
+
+    static int64_t CellKey(int cx, int cy) {
+        return (static_cast<int64_t>(cx) << 32) ^ static_cast<uint32_t>(cy);
+    }
+};
+
+// co_await Wait(seconds):   seconds 
+struct Wait {
+    float seconds;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<BehaviorTask::promise_type> handle) const {
+        auto& promise = handle.promise();
+        promise.scheduler->ScheduleAfter(promise.taskIndex, seconds);
+    }
+    void await_resume() const noexcept {}
+};
+
+// co_await NextTick():    Tick 
+struct NextTick {
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<BehaviorTask::promise_type> handle) const {
+        auto& promise = handle.promise();
+        promise.scheduler->ScheduleNextTick(promise.taskIndex);
+    }
+    void await_resume() const noexcept {}
+};
+
+// co_await UntilPlayerNear(x, y, radius): ,      .
+//  (x, y)   ,      .
+struct UntilPlayerNear {
+    float x, y;
+    float radius;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<BehaviorTask::promise_type> handle) const {
+        auto& promise = handle.promise();
+        promise.scheduler->WatchProximity(promise.taskIndex, x, y, radius);
+    }
+    void await_resume() const noexcept {}
+};
+
+// co_await MoveTo(actor, x, speed):      .
+//    ,       .
+template <class Actor>
+struct MoveTo {
+    Actor& actor;
+    float targetX;
+    float speed;
+
+    bool await_ready() const noexcept { return std::abs(targetX - actor.x) < 0.5f || speed <= 0.0f; }
+    void await_suspend(std::coroutine_handle<BehaviorTask::promise_type> handle) const {
+        float distance = targetX - actor.x;
+        actor.velocityX = distance > 0 ? speed : -speed;
+        auto& promise = handle.promise();
+        promise.scheduler->ScheduleAfter(promise.taskIndex, std::abs(distance) / speed);
+    }
+    void await_resume() const noexcept {
+        actor.x = targetX;
+        actor.velocityX = 0.0f;
+    }
+};
+
+// co_await JumpArc(actor, impulse, gravity):   ,   
+template <class Actor>
+struct JumpArc {
+    Actor& actor;
+    float impulse;
+    float gravity;
+
+    bool await_ready() const noexcept { return impulse <= 0.0f; }
+    void await_suspend(std::coroutine_handle<BehaviorTask::promise_type> handle) const {
+        actor.velocityY = -impulse;
+        auto& promise = handle.promise();
+        promise.scheduler->ScheduleAfter(promise.taskIndex, 2.0f * impulse / gravity);
+    }
+    void await_resume() const noexcept {
+        actor.y = actor.groundY;
+        actor.velocityY = 0.0f;
+    }
+};
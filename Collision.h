@@ -0,0 +1,285 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+//  ,   :       .
+//    CollisionWorld::platforms, -1 -  .
+//    broadphase:    nearbyArea,     nearby    .
+struct ActorContacts {
+    int ground = -1;
+    int left = -1;
+    int right = -1;
+
+    SDL_FRect nearbyArea = { 0.0f, 0.0f, -1.0f, -1.0f };
+    std::vector<int> nearby;    // ,  nearbyArea,   
+    uint64_t queryCount = 0;    //      broadphase
+
+    //  broadphase  :  ,   
+    void Clear() {
+        ground = -1;
+        left = -1;
+        right = -1;
+    }
+};
+
+//      
+enum class ContactSide : uint8_t {
+    None,
+    Ground,     //  
+    Ceiling,    //  
+    Left,       //    
+    Right
+};
+
+//        broadphase.
+//   const,         .
+// MoveX/MoveY -     . Body -    
+// x, y, width, height, velocityX, velocityY  ActorContacts contacts.
+class CollisionWorld {
+public:
+    float CELL_SIZE = 128.0f;
+    float CONTACT_EPSILON = 1.0f;  //     2 ,     feetRect
+    float NEARBY_MARGIN = 32.0f;   //   broadphase  
+
+    std::vector<SDL_FRect> platforms;
+
+    CollisionWorld(const std::vector<SDL_FRect>& levelPlatforms) {
+        platforms = levelPlatforms;
+        BuildGrid();
+    }
+
+    // ,  area (   ),   
+    void Query(const SDL_FRect& area, std::vector<int>& result) const {
+        result.clear();
+        if (platforms.empty()) return;
+
+        int minX = CellX(area.x);
+        int maxX = CellX(area.x + area.w);
+        int minY = CellY(area.y);
+        int maxY = CellY(area.y + area.h);
+
+        for (int cy = minY; cy <= maxY; cy++) {
+            for (int cx = minX; cx <= maxX; cx++) {
+                for (int index : cells[cy * cellsX + cx]) {
+                    if (Touches(area, platforms[index])) result.push_back(index);
+                }
+            }
+        }
+
+        if (minX != maxX || minY != maxY) {
+            std::sort(result.begin(), result.end());
+            result.erase(std::unique(result.begin(), result.end()), result.end());
+        }
+    }
+
+    //     O(1)
+    bool IsStandingOn(const SDL_FRect& rect, int index) const {
+        if (index < 0 || index >= static_cast<int>(platforms.size())) return false;
+        const SDL_FRect& platform = platforms[index];
+
+        float feet = rect.y + rect.h;
+        return feet + CONTACT_EPSILON > platform.y &&
+            feet - CONTACT_EPSILON < platform.y + platform.h &&
+            rect.x < platform.x + platform.w &&
+            rect.x + rect.w > platform.x;
+    }
+
+    //  :        
+    bool IsTouchingLeft(const SDL_FRect& rect, int index) const {
+        if (index < 0 || index >= static_cast<int>(platforms.size())) return false;
+        const SDL_FRect& platform = platforms[index];
+        return std::abs(platform.x + platform.w - rect.x) <= CONTACT_EPSILON && OverlapsVertically(rect, platform);
+    }
+
+    bool IsTouchingRight(const SDL_FRect& rect, int index) const {
+        if (index < 0 || index >= static_cast<int>(platforms.size())) return false;
+        const SDL_FRect& platform = platforms[index];
+        return std::abs(rect.x + rect.w - platform.x) <= CONTACT_EPSILON && OverlapsVertically(rect, platform);
+    }
+
+    //    :  ,   rect    .
+    //       ,       .
+    const std::vector<int>& Nearby(const SDL_FRect& rect, ActorContacts& contacts) const {
+        //  CONTACT_EPSILON -         FindGround
+        const SDL_FRect& area = contacts.nearbyArea;
+        if (rect.x - CONTACT_EPSILON >= area.x && rect.y - CONTACT_EPSILON >= area.y &&
+            rect.x + rect.w + CONTACT_EPSILON <= area.x + area.w &&
+            rect.y + rect.h + CONTACT_EPSILON <= area.y + area.h) {
+            return contacts.nearby;
+        }
+
+        SDL_FRect query = { rect.x - NEARBY_MARGIN, rect.y - NEARBY_MARGIN,
+            rect.w + NEARBY_MARGIN * 2, rect.h + NEARBY_MARGIN * 2 };
+        if (contacts.ground >= 0 && contacts.ground < static_cast<int>(platforms.size())) {
+            const SDL_FRect& ground = platforms[contacts.ground];
+            float left = std::min(query.x, ground.x - NEARBY_MARGIN);
+            float right = std::max(query.x + query.w, ground.x + ground.w + NEARBY_MARGIN);
+            query.x = left;
+            query.w = right - left;
+        }
+
+        Query(query, contacts.nearby);
+        contacts.nearbyArea = query;
+        contacts.queryCount++;
+        return contacts.nearby;
+    }
+
+    //  :    ,    
+    int FindGround(const SDL_FRect& rect, ActorContacts& contacts) const {
+        for (int index : Nearby(rect, contacts)) {
+            if (IsStandingOn(rect, index)) return index;
+        }
+        return -1;
+    }
+
+    //          
+    template <class Body>
+    ContactSide Resolve(Body& body, int index) const {
+        const SDL_FRect& platform = platforms[index];
+
+        //      
+        float overlapLeft = (body.x + body.width) - platform.x;
+        float overlapRight = (platform.x + platform.w) - body.x;
+        float overlapTop = (body.y + body.height) - platform.y;
+        float overlapBottom = (platform.y + platform.h) - body.y;
+        float minOverlap = std::min({ overlapLeft, overlapRight, overlapTop, overlapBottom });
+
+        if (minOverlap == overlapTop && body.velocityY > 0) {
+            body.y = platform.y - body.height;
+            body.velocityY = 0;
+            body.contacts.ground = index;
+            return ContactSide::Ground;
+        }
+        if (minOverlap == overlapBottom && body.velocityY < 0) {
+            body.y = platform.y + platform.h;
+            body.velocityY = 0;
+            return ContactSide::Ceiling;
+        }
+        if (minOverlap == overlapLeft) {
+            body.x = platform.x - body.width;
+            body.velocityX = 0;
+            body.contacts.right = index;
+            return ContactSide::Right;
+        }
+        if (minOverlap == overlapRight) {
+            body.x = platform.x + platform.w;
+            body.velocityX = 0;
+            body.contacts.left = index;
+            return ContactSide::Left;
+        }
+        return ContactSide::None;
+    }
+
+    //   X:    ,  ;   
+    template <class Body>
+    void MoveX(Body& body, float deltaTime) const {
+        body.x += body.velocityX * deltaTime;
+
+        int cachedWall = body.velocityX < 0 ? body.contacts.left : (body.velocityX > 0 ? body.contacts.right : -1);
+        if (cachedWall >= 0 && Overlaps(BodyRect(body), platforms[cachedWall])) {
+            Resolve(body, cachedWall);
+            return;
+        }
+        for (int index : Nearby(BodyRect(body), body.contacts)) {
+            if (Overlaps(BodyRect(body), platforms[index])) {
+                Resolve(body, index);
+                return;
+            }
+        }
+    }
+
+    //   Y:      -   ,    
+    template <class Body>
+    void MoveY(Body& body, float deltaTime) const {
+        body.y += body.velocityY * deltaTime;
+        if (body.velocityY == 0 && IsStandingOn(BodyRect(body), body.contacts.ground)) return;
+
+        body.contacts.ground = -1;
+        for (int index : Nearby(BodyRect(body), body.contacts)) {
+            if (Overlaps(BodyRect(body), platforms[index])) Resolve(body, index);
+        }
+
+        //         -  
+        if (body.contacts.ground < 0 && std::abs(body.velocityY) < 1.0f) {
+            body.contacts.ground = FindGround(BodyRect(body), body.contacts);
+        }
+    }
+
+    //  ,     
+    void ValidateContacts(const SDL_FRect& rect, ActorContacts& contacts) const {
+        if (!IsStandingOn(rect, contacts.ground)) contacts.ground = -1;
+        if (!IsTouchingLeft(rect, contacts.left)) contacts.left = -1;
+        if (!IsTouchingRight(rect, contacts.right)) contacts.right = -1;
+    }
+
+private:
+    float originX = 0.0f;
+    float originY = 0.0f;
+    int cellsX = 1;
+    int cellsY = 1;
+    std::vector<std::vector<int>> cells;
+
+    static bool Touches(const SDL_FRect& a, const SDL_FRect& b) {
+        return a.x <= b.x + b.w && a.x + a.w >= b.x &&
+            a.y <= b.y + b.h && a.y + a.h >= b.y;
+    }
+
+    static bool Overlaps(const SDL_FRect& a, const SDL_FRect& b) {
+        return a.x < b.x + b.w && a.x + a.w > b.x &&
+            a.y < b.y + b.h && a.y + a.h > b.y;
+    }
+
+    template <class Body>
+    static SDL_FRect BodyRect(const Body& body) {
+        return { body.x, body.y, body.width, body.height };
+    }
+
+    static bool OverlapsVertically(const SDL_FRect& a, const SDL_FRect& b) {
+        return a.y < b.y + b.h && a.y + a.h > b.y;
+    }
+
+    //        
+    int CellX(float worldX) const {
+        int cell = static_cast<int>(std::floor((worldX - originX) / CELL_SIZE));
+        return std::clamp(cell, 0, cellsX - 1);
+    }
+
+    int CellY(float worldY) const {
+        int cell = static_cast<int>(std::floor((worldY - originY) / CELL_SIZE));
+        return std::clamp(cell, 0, cellsY - 1);
+    }
+
+    void BuildGrid() {
+        if (platforms.empty()) {
+            cells.assign(1, {});
+            return;
+        }
+
+        float minX = platforms[0].x, minY = platforms[0].y;
+        float maxX = platforms[0].x + platforms[0].w, maxY = platforms[0].y + platforms[0].h;
+        for (const auto& platform : platforms) {
+            minX = std::min(minX, platform.x);
+            minY = std::min(minY, platform.y);
+            maxX = std::max(maxX, platform.x + platform.w);
+            maxY = std::max(maxY, platform.y + platform.h);
+        }
+
+        originX = minX;
+        originY = minY;
+        cellsX = static_cast<int>((maxX - minX) / CELL_SIZE) + 1;
+        cellsY = static_cast<int>((maxY - minY) / CELL_SIZE) + 1;
+        cells.assign(static_cast<size_t>(cellsX) * cellsY, {});
+
+        for (int index = 0; index < static_cast<int>(platforms.size()); index++) {
+            const SDL_FRect& platform = platforms[index];
+            for (int cy = CellY(platform.y); cy <= CellY(platform.y + platform.h); cy++) {
+                for (int cx = CellX(platform.x); cx <= CellX(platform.x + platform.w); cx++) {
+                    cells[cy * cellsX + cx].push_back(index);
+                }
+            }
+        }
+    }
+};
@@ -0,0 +1,149 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+//    (   )
+struct FrameStats {
+    double frameTimeMs = 0.0;       //      Present
+    double jitterMs = 0.0;          //      
+    double averageJitterMs = 0.0;   //  
+    double inputToPresentMs = 0.0;  //       Present
+    double presentWaitMs = 0.0;     //  Present  vsync
+    double workTimeMs = 0.0;        //  +  + 
+    double refreshPeriodMs = 0.0;   //    
+};
+
+//      .
+//  SDL_Delay(16)  vsync    ,  
+//      ,  Present    vsync.
+//  Present   (vsync     ),
+//             .
+class FramePacer {
+public:
+    double SAFETY_MARGIN_MS = 1.5;   //   vsync    
+    double SPIN_THRESHOLD_MS = 2.0;  //     
+    float MAX_DELTA_TIME = 0.1f;     //     
+    double PRESENT_BLOCK_MS = 0.5;   // Present   - , vsync 
+    int UNBLOCKED_FRAMES = 30;       //  Present    - vsync  
+    double PERIOD_TOLERANCE = 0.1;   //        10%
+
+    FramePacer(double refreshRate) {
+        frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+        if (refreshRate <= 0.0) refreshRate = 60.0;
+        refreshPeriod = frequency / refreshRate;
+        nominalPeriod = refreshPeriod;
+        unblockedPresents = 0;
+        workEstimate = 0.0;
+        lastFrameStart = SDL_GetPerformanceCounter();
+        lastPresentEnd = 0;
+        frameStart = lastFrameStart;
+        inputSampled = lastFrameStart;
+        presentStart = lastFrameStart;
+        stats.refreshPeriodMs = ToMs(refreshPeriod);
+    }
+
+    //       deltaTime  
+    float BeginFrame() {
+        if (lastPresentEnd != 0) {
+            double deadline = static_cast<double>(lastPresentEnd) + refreshPeriod
+                - workEstimate - SAFETY_MARGIN_MS * frequency / 1000.0;
+            // Present   vsync -     ,    SDL_Delay(16)
+            if (unblockedPresents >= UNBLOCKED_FRAMES) deadline = static_cast<double>(lastFrameStart) + refreshPeriod;
+            WaitUntil(static_cast<Uint64>(std::max(deadline, 0.0)));
+        }
+
+        frameStart = SDL_GetPerformanceCounter();
+        float deltaTime = static_cast<float>((frameStart - lastFrameStart) / frequency);
+        lastFrameStart = frameStart;
+        inputSampled = frameStart;
+        return std::min(deltaTime, MAX_DELTA_TIME);
+    }
+
+    //      
+    void MarkInputSampled() {
+        inputSampled = SDL_GetPerformanceCounter();
+    }
+
+    void BeginPresent() {
+        presentStart = SDL_GetPerformanceCounter();
+
+        //    ,   ,     vsync
+        double work = static_cast<double>(presentStart - frameStart);
+        if (work > workEstimate) {
+            workEstimate = work;
+        }
+        else {
+            workEstimate += (work - workEstimate) * 0.05;
+        }
+        stats.workTimeMs = ToMs(work);
+    }
+
+    void EndPresent() {
+        Uint64 presentEnd = SDL_GetPerformanceCounter();
+        double presentWait = static_cast<double>(presentEnd - presentStart);
+        bool presentBlocked = ToMs(presentWait) >= PRESENT_BLOCK_MS;
+        unblockedPresents = presentBlocked ? 0 : std::min(unblockedPresents + 1, UNBLOCKED_FRAMES);
+
+        if (lastPresentEnd != 0) {
+            double frameTime = static_cast<double>(presentEnd - lastPresentEnd);
+
+            //   Present,     vsync:      .
+            //      ,        .
+            if (presentBlocked && frameTime > refreshPeriod * 0.5 && frameTime < refreshPeriod * 1.5) {
+                refreshPeriod += (frameTime - refreshPeriod) * 0.02;
+                refreshPeriod = std::clamp(refreshPeriod,
+                    nominalPeriod * (1.0 - PERIOD_TOLERANCE), nominalPeriod * (1.0 + PERIOD_TOLERANCE));
+            }
+
+            stats.frameTimeMs = ToMs(frameTime);
+            stats.jitterMs = std::abs(stats.frameTimeMs - ToMs(refreshPeriod));
+            stats.averageJitterMs += (stats.jitterMs - stats.averageJitterMs) * 0.1;
+        }
+
+        stats.presentWaitMs = ToMs(presentWait);
+        stats.inputToPresentMs = ToMs(static_cast<double>(presentEnd - inputSampled));
+        stats.refreshPeriodMs = ToMs(refreshPeriod);
+        lastPresentEnd = presentEnd;
+    }
+
+    const FrameStats& GetStats() const {
+        return stats;
+    }
+
+private:
+    double frequency;
+    double refreshPeriod;   //   
+    double nominalPeriod;   //    
+    int unblockedPresents;  // Present ,   vsync
+    double workEstimate;    //   
+    Uint64 lastFrameStart;
+    Uint64 lastPresentEnd;
+    Uint64 frameStart;
+    Uint64 inputSampled;
+    Uint64 presentStart;
+    FrameStats stats;
+
+    double ToMs(double ticks) const {
+        return ticks * 1000.0 / frequency;
+    }
+
+    //    SDL_Delay,    
+    void WaitUntil(Uint64 target) {
+        Uint64 spinTicks = static_cast<Uint64>(SPIN_THRESHOLD_MS * frequency / 1000.0);
+        Uint64 now = SDL_GetPerformanceCounter();
+
+        while (now + spinTicks < target) {
+            Uint32 sleepMs = static_cast<Uint32>(ToMs(static_cast<double>(target - now - spinTicks)));
+            if (sleepMs == 0) break;
+            SDL_Delay(sleepMs);
+            now = SDL_GetPerformanceCounter();
+        }
+
+        while (now < target) {
+            std::this_thread::yield();
+            now = SDL_GetPerformanceCounter();
+        }
+    }
+};
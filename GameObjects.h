@@ -0,0 +1,448 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "Behavior.h"
+#include "Collision.h"
+#include "NavGraph.h"
+
+class Coin {
+public:
+    float x, y;
+    float width, height;
+    bool isCollected;
+
+    Coin(float posX, float posY) {
+        x = posX;
+        y = posY;
+        width = 20;
+        height = 20;
+        isCollected = false;
+    }
+
+    SDL_FRect GetRect() const {
+        return { x, y, width, height };
+    }
+
+    //     
+    bool CheckCollision(const SDL_FRect& playerRect) const {
+        if (isCollected) return false;
+
+        return (x < playerRect.x + playerRect.w &&
+            x + width > playerRect.x &&
+            y < playerRect.y + playerRect.h &&
+            y + height > playerRect.y);
+    }
+
+    void Collect() {
+        isCollected = true;
+    }
+};
+
+class Player {
+public:
+    float x, y;          // 
+    float width, height; // 
+    float velocityX, velocityY; // 
+    bool isOnGround;     //   
+    bool canSprint;
+    int lives;
+    int coinsCollected;
+    bool isAlive;
+    float invincibilityTimer;
+    ActorContacts contacts;               // ,    broadphase   
+    bool logEvents = true;                //     
+
+    float NORMAL_SPEED = 200.0f;
+    float SPRINT_SPEED = 350.0f;
+    float INVINCIBILITY_TIME = 2.0f;
+    float GRAVITY = 1000.0f;
+    float JUMP_IMPULSE = 500.0f;
+
+    Player(float startX, float startY) {
+        x = startX;
+        y = startY;
+        width = 50;
+        height = 50;
+        velocityX = 0;
+        velocityY = 0;
+        isOnGround = false;
+        canSprint = true;
+        coinsCollected = 0;
+        lives = 3;
+        isAlive = true;
+        invincibilityTimer = 0.0f;
+    }
+
+    //  bounding box 
+    SDL_FRect GetRect() const {
+        return { x, y, width, height };
+    }
+
+    //     
+    bool CheckCollision(const SDL_FRect& other) const {
+        SDL_FRect rect = GetRect();
+        return (rect.x < other.x + other.w &&
+            rect.x + rect.w > other.x &&
+            rect.y < other.y + other.h &&
+            rect.y + rect.h > other.y);
+    }
+
+    void Update(float deltaTime, const CollisionWorld& world) {
+        //   
+        if (invincibilityTimer > 0) {
+            invincibilityTimer -= deltaTime;
+        }
+
+        //  
+        if (!isOnGround) {
+            velocityY += GRAVITY * deltaTime;
+        }
+        
+        canSprint = isOnGround;
+
+        //     Y  ,     
+        float oldY = y;
+
+        //     X,   Y (. CollisionWorld::MoveX/MoveY)
+        world.MoveX(*this, deltaTime);
+        world.MoveY(*this, deltaTime);
+        isOnGround = contacts.ground >= 0;
+
+        //    (  )
+        if (y > 600) {
+            TakeDamage();
+        }
+        if (x < 0) x = 0;
+        if (x > 800 - width) x = 800 - width; 
+
+        world.ValidateContacts(GetRect(), contacts);
+    }
+    //    
+    void TakeDamage() {
+        if (invincibilityTimer > 0 || !isAlive) return;
+
+        lives--;
+        invincibilityTimer = INVINCIBILITY_TIME;
+
+        if (logEvents) std::cout << "Player hit! Lives: " << lives << std::endl;
+
+        if (lives <= 0) {
+            isAlive = false;
+            if (logEvents) std::cout << "Game Over!" << std::endl;
+        }
+        else {
+            //    
+            x = 100;
+            y = 100;
+            velocityX = 0;
+            velocityY = 0;
+            contacts.Clear();
+        }
+    }
+
+    //     ( )
+    bool IsInvincible() const {
+        return invincibilityTimer > 0;
+    }
+
+    void Jump() {
+        if (isOnGround) {
+            velocityY = -JUMP_IMPULSE;
+            isOnGround = false;
+            contacts.ground = -1;
+        }
+    }
+
+    void MoveLeft(bool isSprinting = false) {
+        if (isSprinting && canSprint) {
+            velocityX = -SPRINT_SPEED;
+        }
+        else {
+            velocityX = -NORMAL_SPEED;
+        }
+    }
+
+    void MoveRight(bool isSprinting = false) {
+        if (isSprinting && canSprint) {
+            velocityX = SPRINT_SPEED;
+        }
+        else {
+            velocityX = NORMAL_SPEED;
+        }
+    }
+
+    void Stop() {
+        velocityX = 0;
+    }
+
+    void CollectCoin() {
+        coinsCollected++;
+        if (logEvents) std::cout << "Coin collected! Total: " << coinsCollected << std::endl;
+    }
+};
+
+class Enemy {
+public:
+    float x, y;
+    float width, height;
+    float velocityX, velocityY;
+    float patrolDistance;
+    float startX;
+    float groundY;       // ,      
+    bool isActive;
+    bool usesPhysics;    //      ,    groundY
+    ActorContacts contacts;
+
+    float SPEED = 50.0f;
+    float CHASE_SPEED = 90.0f;
+    float JUMP_IMPULSE = 350.0f;
+    float GRAVITY = 1000.0f;
+    float PURSUIT_SPEED = 160.0f;
+    float MAX_PHYSICS_STEP = 1.0f / 60.0f;
+    float FALL_LIMIT = 2000.0f;           //    -   
+
+    Enemy(float posX, float posY, float patrolDist = 100.0f) {
+        x = posX;
+        y = posY;
+        width = 40;
+        height = 40;
+        velocityX = 0.0f;
+        velocityY = 0.0f;
+        patrolDistance = patrolDist;
+        startX = posX;
+        groundY = posY;
+        isActive = true;
+        usesPhysics = false;
+    }
+
+    SDL_FRect GetRect() const {
+        return { x, y, width, height };
+    }
+
+    //  :     (. PatrolBehavior  .)
+    void Update(float deltaTime) {
+        if (!isActive) return;
+
+        x += velocityX * deltaTime;
+
+        if (velocityY != 0 || y < groundY) {
+            velocityY += GRAVITY * deltaTime;
+            y += velocityY * deltaTime;
+            if (y >= groundY) {
+                y = groundY;
+                velocityY = 0;
+            }
+        }
+    }
+
+    //      ;  LOD-   
+    void Update(float deltaTime, const CollisionWorld& world) {
+        if (!usesPhysics) {
+            Update(deltaTime);
+            return;
+        }
+        if (!isActive) return;
+
+        int steps = std::max(1, static_cast<int>(std::ceil(deltaTime / MAX_PHYSICS_STEP)));
+        for (int i = 0; i < steps; i++) {
+            PhysicsStep(deltaTime / steps, world);
+        }
+    }
+
+    bool IsOnGround() const {
+        return contacts.ground >= 0;
+    }
+
+    void Jump(float impulse) {
+        if (!IsOnGround()) return;
+        velocityY = -impulse;
+        contacts.ground = -1;
+    }
+
+    void Reset() {
+        x = startX;
+        y = groundY;
+        velocityX = 0;
+        velocityY = 0;
+        isActive = true;
+        contacts.Clear();
+    }
+
+    //    
+    bool CheckCollision(const SDL_FRect& playerRect) const {
+        if (!isActive) return false;
+
+        return (x < playerRect.x + playerRect.w &&
+            x + width > playerRect.x &&
+            y < playerRect.y + playerRect.h &&
+            y + height > playerRect.y);
+    }
+
+private:
+    //   ,   :       broadphase  
+    void PhysicsStep(float deltaTime, const CollisionWorld& world) {
+        //   ;    -  ,   - 
+        if (velocityY >= 0 && !world.IsStandingOn(GetRect(), contacts.ground)) {
+            contacts.ground = world.FindGround(GetRect(), contacts);
+        }
+        if (IsOnGround()) {
+            velocityY = 0;
+        }
+        else {
+            velocityY += GRAVITY * deltaTime;
+        }
+
+        world.MoveX(*this, deltaTime);
+        world.MoveY(*this, deltaTime);
+        world.ValidateContacts(GetRect(), contacts);
+
+        if (y > FALL_LIMIT) Reset();
+    }
+};
+
+//        
+inline BehaviorTask PatrolBehavior(Enemy& enemy, float pause) {
+    for (;;) {
+        co_await MoveTo{ enemy, enemy.startX + enemy.patrolDistance, enemy.SPEED };
+        co_await Wait{ pause };
+        co_await MoveTo{ enemy, enemy.startX - enemy.patrolDistance, enemy.SPEED };
+        co_await Wait{ pause };
+    }
+}
+
+//      
+inline BehaviorTask JumperBehavior(Enemy& enemy) {
+    for (;;) {
+        co_await MoveTo{ enemy, enemy.startX + enemy.patrolDistance, enemy.SPEED };
+        co_await JumpArc{ enemy, enemy.JUMP_IMPULSE, enemy.GRAVITY };
+        co_await MoveTo{ enemy, enemy.startX - enemy.patrolDistance, enemy.SPEED };
+        co_await JumpArc{ enemy, enemy.JUMP_IMPULSE, enemy.GRAVITY };
+    }
+}
+
+//   ,    ,       
+inline BehaviorTask SentryBehavior(Enemy& enemy, BehaviorScheduler& scheduler, float radius) {
+    const float CHASE_STEP = 0.2f;  //    
+
+    for (;;) {
+        co_await UntilPlayerNear{ enemy.x + enemy.width / 2, enemy.y + enemy.height / 2, radius };
+
+        SDL_FPoint player;
+        float distanceSquared;
+        while (scheduler.NearestTarget(enemy.x + enemy.width / 2, enemy.y + enemy.height / 2, player, distanceSquared) &&
+            distanceSquared <= radius * radius * 2.25f) {
+            float targetX = std::clamp(player.x - enemy.width / 2,
+                enemy.startX - enemy.patrolDistance, enemy.startX + enemy.patrolDistance);
+            float step = std::min(CHASE_STEP, std::abs(targetX - enemy.x) / enemy.CHASE_SPEED);
+
+            if (step < 0.01f) {
+                co_await Wait{ CHASE_STEP };
+                continue;
+            }
+            enemy.velocityX = targetX > enemy.x ? enemy.CHASE_SPEED : -enemy.CHASE_SPEED;
+            co_await Wait{ step };
+            enemy.velocityX = 0;
+        }
+
+        //   -   
+        co_await MoveTo{ enemy, enemy.startX, enemy.SPEED };
+    }
+}
+
+//       :       ,
+//  -         ,     landingX
+inline BehaviorTask PursueBehavior(Enemy& enemy, BehaviorScheduler& scheduler, const NavGraph& graph, const NavFlowField& flow) {
+    const float STEP = 0.1f;         //    
+    const float AIR_STEP = 0.02f;    //     
+    const float TAKEOFF_TOLERANCE = 3.0f;
+    enemy.GRAVITY = graph.agent.gravity;  //      -   
+
+    for (;;) {
+        int node = enemy.contacts.ground;
+        if (node < 0 || !flow.IsValid()) {
+            co_await Wait{ node < 0 ? AIR_STEP : STEP };
+            continue;
+        }
+
+        float targetX;
+        int edgeIndex = -1;
+        if (flow.IsGoal(node)) {
+            SDL_FPoint player;
+            float distanceSquared;
+            if (!scheduler.NearestTarget(enemy.x + enemy.width / 2, enemy.y + enemy.height / 2, player, distanceSquared)) {
+                enemy.velocityX = 0;
+                co_await Wait{ STEP };
+                continue;
+            }
+            const SDL_FRect& platform = graph.platforms[node];
+            targetX = std::clamp(player.x - enemy.width / 2, platform.x, platform.x + platform.w - enemy.width);
+        }
+        else {
+            edgeIndex = flow.NextEdge(node);
+            if (edgeIndex < 0) {
+                //      - ,    
+                enemy.velocityX = 0;
+                co_await Wait{ 0.5f };
+                continue;
+            }
+            targetX = graph.edges[edgeIndex].takeoffX;
+        }
+
+        float distance = targetX - enemy.x;
+        if (std::abs(distance) > TAKEOFF_TOLERANCE || edgeIndex < 0) {
+            enemy.velocityX = std::abs(distance) > TAKEOFF_TOLERANCE ? (distance > 0 ? enemy.PURSUIT_SPEED : -enemy.PURSUIT_SPEED) : 0.0f;
+            co_await Wait{ std::clamp(std::abs(distance) / enemy.PURSUIT_SPEED, AIR_STEP, STEP) };
+            continue;
+        }
+
+        //   :    ,      .
+        //     ,     ,   .
+        const NavEdge& edge = graph.edges[edgeIndex];
+        const SDL_FRect& landingPlatform = graph.platforms[edge.to];
+        bool isJump = edge.type == NavEdgeType::Jump;
+        enemy.x = edge.takeoffX;
+        if (isJump) enemy.Jump(graph.agent.jumpImpulse);
+
+        double giveUp = scheduler.Now() + edge.cost * 2.0 + 0.5;
+        do {
+            float remaining = edge.landingX - enemy.x;
+            float direction = std::abs(remaining) < 1.0f ? 0.0f : (remaining > 0 ? 1.0f : -1.0f);
+            float nextX = enemy.x + direction * 2.0f;
+            bool belowTop = enemy.y + enemy.height > landingPlatform.y;
+            bool underTarget = nextX < landingPlatform.x + landingPlatform.w && nextX + enemy.width > landingPlatform.x;
+            if (isJump && belowTop && underTarget && enemy.velocityY < 0) direction = 0.0f;
+            enemy.velocityX = direction * enemy.PURSUIT_SPEED;
+            co_await Wait{ AIR_STEP };
+        } while ((isJump ? !enemy.IsOnGround() : enemy.contacts.ground == node || !enemy.IsOnGround()) &&
+            scheduler.Now() < giveUp);
+        enemy.velocityX = 0;
+    }
+}
+
+enum class EnemyBehaviorKind {
+    Patrol,
+    SlowPatrol,
+    Jumper,
+    Sentry,
+    Pursuer
+};
+
+inline BehaviorTask StartEnemyBehavior(Enemy& enemy, BehaviorScheduler& scheduler, EnemyBehaviorKind kind,
+    const NavGraph& graph, const NavFlowField& flow) {
+    switch (kind) {
+    case EnemyBehaviorKind::Pursuer:
+        return PursueBehavior(enemy, scheduler, graph, flow);
+    case EnemyBehaviorKind::SlowPatrol:
+        return PatrolBehavior(enemy, 1.0f);
+    case EnemyBehaviorKind::Jumper:
+        return JumperBehavior(enemy);
+    case EnemyBehaviorKind::Sentry:
+        return SentryBehavior(enemy, scheduler, 200.0f);
+    default:
+        return PatrolBehavior(enemy, 0.5f);
+    }
+}
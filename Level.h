@@ -0,0 +1,98 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+
+#include "Collision.h"
+#include "GameObjects.h"
+#include "NavGraph.h"
+
+struct EnemySpawn {
+    float x, y;
+    float patrolDistance;
+    EnemyBehaviorKind behavior;
+};
+
+//   .    ,     .
+//         .
+class Level {
+public:
+    std::vector<SDL_FRect> platforms;
+    std::vector<SDL_FPoint> coinSpawns;
+    std::vector<EnemySpawn> enemySpawns;
+    CollisionWorld collision;
+    NavGraph navigation;
+
+    Level(const std::vector<SDL_FRect>& levelPlatforms, const std::vector<SDL_FPoint>& coins,
+        const std::vector<EnemySpawn>& enemies)
+        : platforms(levelPlatforms), coinSpawns(coins), enemySpawns(enemies), collision(levelPlatforms),
+        navigation(levelPlatforms, PursuerAgent()) {
+    }
+
+    //     :    ,    
+    static NavAgent PursuerAgent() {
+        Player player(0, 0);
+        Enemy pursuer(0, 0);
+        NavAgent agent;
+        agent.width = pursuer.width;
+        agent.height = pursuer.height;
+        agent.runSpeed = pursuer.PURSUIT_SPEED;
+        agent.jumpImpulse = player.JUMP_IMPULSE;
+        agent.gravity = player.GRAVITY;
+        return agent;
+    }
+
+    std::vector<Coin> CreateCoins() const {
+        std::vector<Coin> coins;
+        for (const auto& spawn : coinSpawns) coins.push_back(Coin(spawn.x, spawn.y));
+        return coins;
+    }
+
+    std::vector<Enemy> CreateEnemies() const {
+        std::vector<Enemy> enemies;
+        enemies.reserve(enemySpawns.size());
+        for (const auto& spawn : enemySpawns) {
+            enemies.push_back(Enemy(spawn.x, spawn.y, spawn.patrolDistance));
+            enemies.back().usesPhysics = spawn.behavior == EnemyBehaviorKind::Pursuer;
+        }
+        return enemies;
+    }
+
+    //  enemies      ;
+    // flow -        
+    void StartBehaviors(std::vector<Enemy>& enemies, BehaviorScheduler& scheduler, const NavFlowField& flow) const {
+        scheduler.Clear();
+        for (size_t i = 0; i < enemies.size() && i < enemySpawns.size(); i++) {
+            scheduler.Spawn(StartEnemyBehavior(enemies[i], scheduler, enemySpawns[i].behavior, navigation, flow));
+        }
+    }
+};
+
+inline Level LoadDefaultLevel() {
+    //   (x, y, width, height)
+    std::vector<SDL_FRect> platforms = {
+        {200.0f, 400.0f, 400.0f, 20.0f},  //  
+        {100.0f, 300.0f, 200.0f, 20.0f},  //  
+        {500.0f, 250.0f, 200.0f, 20.0f},  //  
+        {0.0f, 580.0f, 800.0f, 20.0f},    // 
+        {50.0f, 500.0f, 100.0f, 20.0f},   //  
+        {650.0f, 450.0f, 100.0f, 20.0f}   //  
+    };
+
+    std::vector<SDL_FPoint> coins = {
+        {250.0f, 350.0f},  //    
+        {150.0f, 250.0f},  //    
+        {550.0f, 200.0f},  //    
+        {75.0f, 450.0f},   //  
+        {675.0f, 400.0f}   //   
+    };
+
+    std::vector<EnemySpawn> enemies = {
+        {300.0f, 350.0f, 150.0f, EnemyBehaviorKind::Patrol},     //    
+        {150.0f, 250.0f, 80.0f, EnemyBehaviorKind::Jumper},      //     
+        {550.0f, 200.0f, 100.0f, EnemyBehaviorKind::Sentry},     //     
+        {50.0f, 450.0f, 50.0f, EnemyBehaviorKind::SlowPatrol},   //    
+        {700.0f, 540.0f, 0.0f, EnemyBehaviorKind::Pursuer}       //   
+    };
+
+    return Level(platforms, coins, enemies);
+}
@@ -0,0 +1,188 @@
+#define SDL_MAIN_HANDLED
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Level.h"
+#include "Metrics.h"
+#include "RoomClient.h"
+#include "RoomServer.h"
+
+// PlatformerLoadGen [--rooms N] [--players N] [--seconds N] [--threads N] [--server host:port]
+//
+//        60 .  --server  
+//      loopback          .
+int main(int argc, char* argv[]) {
+    int roomCount = 256;
+    int playersPerRoom = Room::MAX_PLAYERS;
+    int seconds = 10;
+    int threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    std::string serverHost = "127.0.0.1";
+    uint16_t serverPort = 0;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string option = argv[i];
+        if (option == "--rooms") roomCount = std::max(1, std::atoi(argv[i + 1]));
+        else if (option == "--players") playersPerRoom = std::clamp(std::atoi(argv[i + 1]), 1, Room::MAX_PLAYERS);
+        else if (option == "--seconds") seconds = std::max(1, std::atoi(argv[i + 1]));
+        else if (option == "--threads") threadCount = std::max(1, std::atoi(argv[i + 1]));
+        else if (option == "--server") {
+            serverPort = DEFAULT_SERVER_PORT;
+            ParseHostPort(argv[i + 1], serverHost, serverPort);
+            sockaddr_in parsed;
+            if (!MakeAddress(serverHost, serverPort, parsed)) {
+                std::cerr << "--server: " << serverHost << " is not an IPv4 address (host names are not resolved)" << std::endl;
+                return 1;
+            }
+        }
+        else {
+            std::cerr << "Unknown option " << option << std::endl;
+            return 1;
+        }
+    }
+    threadCount = std::max(1, threadCount);
+
+    //  
+    Level level = LoadDefaultLevel();
+    MetricsRegistry metrics;
+    std::unique_ptr<RoomServer> server;
+    std::atomic<bool> serverRunning(true);
+    std::thread serverThread;
+    bool embedded = serverPort == 0;
+
+    if (embedded) {
+        server = std::make_unique<RoomServer>(level, roomCount, threadCount, metrics);
+        if (!server->Open("127.0.0.1", 0)) {
+            std::cerr << "Cannot open server socket" << std::endl;
+            return 1;
+        }
+        serverPort = server->Port();
+        serverThread = std::thread([&server, &serverRunning]() { server->Run(serverRunning); });
+    }
+
+    //    ;    clientId  
+    const int SOCKET_COUNT = 8;
+    std::vector<std::unique_ptr<UdpSocket>> sockets;
+    for (int i = 0; i < SOCKET_COUNT; i++) {
+        sockets.push_back(std::make_unique<UdpSocket>());
+        if (!sockets.back()->Open("0.0.0.0", 0)) {
+            std::cerr << "Cannot open client socket" << std::endl;
+            serverRunning = false;
+            if (serverThread.joinable()) serverThread.join();
+            return 1;
+        }
+    }
+
+    std::mt19937 random(12345);
+    uint32_t idBase = embedded ? 1 : (random() & 0x7FFFFFFF);
+    sockaddr_in serverAddress;
+    MakeAddress(serverHost, serverPort, serverAddress);
+
+    std::vector<RoomClient> clients;
+    std::vector<uint8_t> buttons;
+    std::unordered_map<uint32_t, size_t> clientIndex;
+    for (int room = 0; room < roomCount; room++) {
+        for (int player = 0; player < playersPerRoom; player++) {
+            uint32_t id = idBase + static_cast<uint32_t>(clients.size());
+            clientIndex[id] = clients.size();
+            clients.emplace_back(id, static_cast<uint16_t>(room), serverAddress);
+            buttons.push_back(0);
+        }
+    }
+
+    std::cout << "Load: " << roomCount << " rooms x " << playersPerRoom << " players, "
+        << seconds << " s, server " << serverHost << ":" << serverPort
+        << (embedded ? " (embedded, " + std::to_string(server->ThreadCount()) + " threads)" : "") << std::endl;
+
+    const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / 60.0));
+    const int TICKS = seconds * 60;
+    auto nextTick = std::chrono::steady_clock::now();
+    uint8_t buffer[MAX_PACKET_SIZE];
+
+    for (int tick = 0; tick < TICKS; tick++) {
+        for (auto& socket : sockets) {
+            sockaddr_in from;
+            int size;
+            while ((size = socket->ReceiveFrom(buffer, sizeof(buffer), from)) > 0) {
+                PacketReader in(buffer, static_cast<size_t>(size));
+                uint8_t type;
+                uint32_t clientId;
+                if (!SameAddress(from, serverAddress) || !ReadPacketHeader(in, type, clientId)) continue;
+                auto client = clientIndex.find(clientId);
+                if (client != clientIndex.end()) clients[client->second].HandlePacket(type, in);
+            }
+        }
+
+        for (size_t i = 0; i < clients.size(); i++) {
+            RoomClient& client = clients[i];
+            const UdpSocket& socket = *sockets[i % SOCKET_COUNT];
+
+            if (!client.isConnected) {
+                if (!client.isRejected && (tick + i) % 30 == 0) client.SendHello(socket);
+                continue;
+            }
+
+            //       ,  
+            if (random() % 30 == 0) {
+                uint32_t roll = random();
+                buttons[i] = static_cast<uint8_t>((roll % 3 == 0 ? BUTTON_LEFT : (roll % 3 == 1 ? BUTTON_RIGHT : 0)) |
+                    ((roll >> 4) % 4 == 0 ? BUTTON_SPRINT : 0));
+            }
+            uint8_t pressed = buttons[i];
+            if (random() % 20 == 0) pressed |= BUTTON_JUMP;
+            client.SendInput(socket, pressed);
+        }
+
+        nextTick += period;
+        std::this_thread::sleep_until(nextTick);
+    }
+
+    for (size_t i = 0; i < clients.size(); i++) {
+        if (clients[i].isConnected) clients[i].SendLeave(*sockets[i % SOCKET_COUNT]);
+    }
+    serverRunning = false;
+    if (serverThread.joinable()) serverThread.join();
+
+    uint64_t connected = 0, rejected = 0, snapshots = 0, decodeFailures = 0, bytes = 0;
+    for (const auto& client : clients) {
+        connected += client.isConnected ? 1 : 0;
+        rejected += client.isRejected ? 1 : 0;
+        snapshots += client.snapshotsReceived;
+        decodeFailures += client.decodeFailures;
+        bytes += client.bytesReceived;
+    }
+
+    std::cout << "Clients:   " << connected << "/" << clients.size() << " connected, " << rejected << " rejected" << std::endl;
+    std::cout << "Snapshots: " << snapshots / seconds << " /s, " << decodeFailures << " decode failures" << std::endl;
+    std::cout << "Downlink:  " << bytes / seconds / 1024 << " KB/s total, "
+        << (snapshots ? bytes / snapshots : 0) << " bytes/snapshot" << std::endl;
+
+    if (embedded) {
+        const LatencyHistogram& tickTime = server->tickTime;
+        const LatencyHistogram& stepTime = server->roomStepTime;
+        std::cout << "Tick:      p50 " << tickTime.Quantile(0.5) / 1e6 << " ms, p90 " << tickTime.Quantile(0.9) / 1e6
+            << " ms, p99 " << tickTime.Quantile(0.99) / 1e6 << " ms, max " << tickTime.Max() / 1e6 << " ms" << std::endl;
+        std::cout << "Room step: p50 " << stepTime.Quantile(0.5) / 1e3 << " us, p99 " << stepTime.Quantile(0.99) / 1e3
+            << " us, mean " << stepTime.Mean() / 1e3 << " us" << std::endl;
+
+        //         :
+        //   16.67  / (  x  / )
+        double coreNsPerRoom = tickTime.Mean() * server->ThreadCount() / server->RoomCount();
+        double roomsPerCore = coreNsPerRoom > 0 ? (1e9 / 60.0) / coreNsPerRoom : 0.0;
+        double stepOnlyRoomsPerCore = stepTime.Mean() > 0 ? (1e9 / 60.0) / stepTime.Mean() : 0.0;
+        std::cout << "Capacity:  " << static_cast<int>(roomsPerCore) << " rooms/core at 60 Hz from tick wall time ("
+            << server->packetsSent.Value() / seconds << " packets/s sent)" << std::endl;
+        std::cout << "           " << static_cast<int>(stepOnlyRoomsPerCore)
+            << " rooms/core from room step only (ignores serial receive, upper bound)" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,300 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "Net.h"
+
+//    HDR: -   .
+//  -     ,     .
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 4;                        // 16   ,  ~6%
+    static const int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static const int MAX_EXPONENT = 36;                          //  ~68 
+    static const int BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKET_COUNT;
+
+    std::string name;
+    std::string help;
+
+    LatencyHistogram(const std::string& metricName, const std::string& metricHelp)
+        : name(metricName), help(metricHelp), counts(BUCKET_COUNT) {
+        totalCount = 0;
+        totalSum = 0;
+        maxValue = 0;
+    }
+
+    void Record(uint64_t nanoseconds) {
+        counts[BucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+        totalCount.fetch_add(1, std::memory_order_relaxed);
+        totalSum.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+        uint64_t currentMax = maxValue.load(std::memory_order_relaxed);
+        while (nanoseconds > currentMax &&
+            !maxValue.compare_exchange_weak(currentMax, nanoseconds, std::memory_order_relaxed)) {
+        }
+    }
+
+    uint64_t Count() const {
+        return totalCount.load(std::memory_order_relaxed);
+    }
+
+    uint64_t Max() const {
+        return maxValue.load(std::memory_order_relaxed);
+    }
+
+    double Mean() const {
+        uint64_t total = Count();
+        return total ? static_cast<double>(totalSum.load(std::memory_order_relaxed)) / total : 0.0;
+    }
+
+    //   ,     q (0..1)
+    uint64_t Quantile(double q) const {
+        uint64_t total = Count();
+        if (total == 0) return 0;
+
+        uint64_t rank = static_cast<uint64_t>(q * total);
+        if (rank >= total) rank = total - 1;
+
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKET_COUNT; i++) {
+            seen += counts[i].load(std::memory_order_relaxed);
+            if (seen > rank) return std::min(BucketUpperBound(i), Max());
+        }
+        return Max();
+    }
+
+    //  Prometheus:    ,  
+    void WritePrometheus(std::ostream& out) const {
+        out << "# HELP " << name << " " << help << "\n";
+        out << "# TYPE " << name << " histogram\n";
+
+        uint64_t cumulative = 0;
+        for (int i = 0; i < BUCKET_COUNT; i++) {
+            uint64_t bucket = counts[i].load(std::memory_order_relaxed);
+            if (bucket == 0) continue;
+            cumulative += bucket;
+            out << name << "_bucket{le=\"" << BucketUpperBound(i) * 1e-9 << "\"} " << cumulative << "\n";
+        }
+        out << name << "_bucket{le=\"+Inf\"} " << cumulative << "\n";
+        out << name << "_sum " << totalSum.load(std::memory_order_relaxed) * 1e-9 << "\n";
+        out << name << "_count " << cumulative << "\n";
+    }
+
+    static int BucketIndex(uint64_t value) {
+        if (value < SUB_BUCKET_COUNT) return static_cast<int>(value);
+
+        int exponent = HighestBit(value);
+        if (exponent > MAX_EXPONENT) return BUCKET_COUNT - 1;
+
+        int mantissa = static_cast<int>((value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1));
+        return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT + mantissa;
+    }
+
+    //  ,    
+    static uint64_t BucketUpperBound(int index) {
+        if (index < SUB_BUCKET_COUNT) return static_cast<uint64_t>(index);
+
+        int exponent = index / SUB_BUCKET_COUNT + SUB_BUCKET_BITS - 1;
+        uint64_t mantissa = static_cast<uint64_t>(index % SUB_BUCKET_COUNT);
+        int shift = exponent - SUB_BUCKET_BITS;
+        return ((SUB_BUCKET_COUNT + mantissa + 1) << shift) - 1;
+    }
+
+private:
+    std::vector<std::atomic<uint64_t>> counts;
+    std::atomic<uint64_t> totalCount;
+    std::atomic<uint64_t> totalSum;
+    std::atomic<uint64_t> maxValue;
+
+    static int HighestBit(uint64_t value) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return static_cast<int>(index);
+#else
+        return 63 - __builtin_clzll(value);
+#endif
+    }
+};
+
+class MetricCounter {
+public:
+    std::string name;
+    std::string help;
+
+    MetricCounter(const std::string& metricName, const std::string& metricHelp)
+        : name(metricName), help(metricHelp) {
+        value = 0;
+    }
+
+    void Add(uint64_t amount) {
+        value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    uint64_t Value() const {
+        return value.load(std::memory_order_relaxed);
+    }
+
+    void WritePrometheus(std::ostream& out) const {
+        out << "# HELP " << name << " " << help << "\n";
+        out << "# TYPE " << name << " counter\n";
+        out << name << " " << Value() << "\n";
+    }
+
+private:
+    std::atomic<uint64_t> value;
+};
+
+//   .      ,
+//         .
+class MetricsRegistry {
+public:
+    LatencyHistogram& AddHistogram(const std::string& name, const std::string& help) {
+        histograms.push_back(std::make_unique<LatencyHistogram>(name, help));
+        return *histograms.back();
+    }
+
+    MetricCounter& AddCounter(const std::string& name, const std::string& help) {
+        counters.push_back(std::make_unique<MetricCounter>(name, help));
+        return *counters.back();
+    }
+
+    std::string ToPrometheusText() const {
+        std::ostringstream out;
+        for (const auto& histogram : histograms) histogram->WritePrometheus(out);
+        for (const auto& counter : counters) counter->WritePrometheus(out);
+        return out.str();
+    }
+
+private:
+    std::vector<std::unique_ptr<LatencyHistogram>> histograms;
+    std::vector<std::unique_ptr<MetricCounter>> counters;
+};
+
+//  :        
+//   Prometheus  http://127.0.0.1:<port>/metrics
+class MetricsExporter {
+public:
+    int PORT_ATTEMPTS = 10;  //      
+
+    MetricsExporter(const MetricsRegistry& metricsRegistry, uint16_t basePort,
+        const std::string& dumpPath, int dumpIntervalSeconds)
+        : registry(metricsRegistry), filePath(dumpPath) {
+        port = basePort;
+        intervalSeconds = dumpIntervalSeconds;
+        running = false;
+    }
+
+    ~MetricsExporter() {
+        Stop();
+    }
+
+    void Start() {
+        if (running) return;
+
+        bool listening = false;
+        for (int i = 0; i < PORT_ATTEMPTS && !listening; i++) {
+            listening = listener.Open(static_cast<uint16_t>(port + i));
+        }
+        if (listening) {
+            std::cout << "Metrics: http://127.0.0.1:" << listener.port << "/metrics" << std::endl;
+        }
+        else {
+            std::cerr << "Metrics: no free port near " << port << ", file export only" << std::endl;
+        }
+
+        running = true;
+        worker = std::thread([this]() { Run(); });
+    }
+
+    void Stop() {
+        if (!running) return;
+        running = false;
+        if (worker.joinable()) worker.join();
+        listener.Close();
+        DumpToFile();
+    }
+
+private:
+    const MetricsRegistry& registry;
+    std::string filePath;
+    uint16_t port;
+    int intervalSeconds;
+    std::atomic<bool> running;
+    std::thread worker;
+    TcpListener listener;
+
+    void Run() {
+        auto nextDump = std::chrono::steady_clock::now() + std::chrono::seconds(intervalSeconds);
+
+        while (running) {
+            if (listener.socket != INVALID_SOCKET) {
+                SocketHandle client = listener.Accept(200);
+                if (client != INVALID_SOCKET) Serve(client);
+            }
+            else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            }
+
+            if (std::chrono::steady_clock::now() >= nextDump) {
+                DumpToFile();
+                nextDump += std::chrono::seconds(intervalSeconds);
+            }
+        }
+    }
+
+    void Serve(SocketHandle client) {
+        //   :     
+        char request[1024];
+        if (WaitReadable(client, 500)) {
+            recv(client, request, sizeof(request), 0);
+        }
+
+        std::string body = registry.ToPrometheusText();
+        std::string response = "HTTP/1.0 200 OK\r\n"
+            "Content-Type: text/plain; version=0.0.4\r\n"
+            "Content-Length: " + std::to_string(body.size()) + "\r\n"
+            "Connection: close\r\n\r\n" + body;
+
+        int flags = 0;
+#ifdef MSG_NOSIGNAL
+        flags = MSG_NOSIGNAL;
+#endif
+        size_t sent = 0;
+        while (sent < response.size()) {
+            int result = send(client, response.data() + sent, static_cast<int>(response.size() - sent), flags);
+            if (result <= 0) break;
+            sent += static_cast<size_t>(result);
+        }
+        CloseSocket(client);
+    }
+
+    //      ,     
+    void DumpToFile() {
+        if (filePath.empty()) return;
+
+        std::string tempPath = filePath + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::trunc);
+            if (!file) return;
+            file << registry.ToPrometheusText();
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tempPath, filePath, error);
+    }
+};
@@ -0,0 +1,276 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <vector>
+
+//    :      ,   
+struct NavAgent {
+    float width = 40.0f;
+    float height = 40.0f;
+    float runSpeed = 160.0f;
+    float jumpImpulse = 500.0f;
+    float gravity = 1000.0f;
+};
+
+enum class NavEdgeType : uint8_t {
+    Walk,   //      
+    Jump,   //    (    )
+    Fall    //          
+};
+
+// :   takeoffX (  ),  ,     landingX
+struct NavEdge {
+    int from;
+    int to;
+    NavEdgeType type;
+    float takeoffX;
+    float landingX;
+    float cost;      // :         
+};
+
+//     .  -   (  
+// CollisionWorld::platforms),       .
+//      :     .
+class NavGraph {
+public:
+    float WALK_GAP = 1.0f;          // ,    
+    float JUMP_MARGIN = 0.9f;       //     
+    float HEIGHT_MARGIN = 4.0f;     //   
+    float TAKEOFF_CLEARANCE = 1.0f; //    ,   
+
+    NavAgent agent;
+    std::vector<SDL_FRect> platforms;
+    std::vector<NavEdge> edges;         //   from
+    std::vector<int> edgeStart;         //   n: [edgeStart[n], edgeStart[n + 1])
+    std::vector<int> incoming;          //  ,   to
+    std::vector<int> incomingStart;
+
+    NavGraph() {
+        edgeStart.assign(1, 0);
+        incomingStart.assign(1, 0);
+    }
+
+    NavGraph(const std::vector<SDL_FRect>& levelPlatforms, const NavAgent& navAgent) {
+        platforms = levelPlatforms;
+        agent = navAgent;
+        Build();
+    }
+
+    int NodeCount() const {
+        return static_cast<int>(platforms.size());
+    }
+
+    //  ,    
+    float JumpHeight() const {
+        return agent.jumpImpulse * agent.jumpImpulse / (2.0f * agent.gravity);
+    }
+
+private:
+    void Build() {
+        int count = NodeCount();
+        for (int from = 0; from < count; from++) {
+            for (int to = 0; to < count; to++) {
+                if (from != to) AddWalkOrJump(from, to);
+            }
+            AddFall(from, true);
+            AddFall(from, false);
+        }
+
+        std::stable_sort(edges.begin(), edges.end(), [](const NavEdge& a, const NavEdge& b) { return a.from < b.from; });
+        edgeStart.assign(count + 1, 0);
+        for (const auto& edge : edges) edgeStart[edge.from + 1]++;
+        for (int n = 0; n < count; n++) edgeStart[n + 1] += edgeStart[n];
+
+        incoming.resize(edges.size());
+        for (size_t i = 0; i < edges.size(); i++) incoming[i] = static_cast<int>(i);
+        std::stable_sort(incoming.begin(), incoming.end(), [this](int a, int b) { return edges[a].to < edges[b].to; });
+        incomingStart.assign(count + 1, 0);
+        for (const auto& edge : edges) incomingStart[edge.to + 1]++;
+        for (int n = 0; n < count; n++) incomingStart[n + 1] += incomingStart[n];
+    }
+
+    //   ,     (  -  )
+    float ClampOnto(const SDL_FRect& platform, float x) const {
+        if (platform.w <= agent.width) return platform.x + (platform.w - agent.width) / 2;
+        return std::clamp(x, platform.x, platform.x + platform.w - agent.width);
+    }
+
+    float WalkTime(const SDL_FRect& platform, float x) const {
+        return std::abs(x - (platform.x + platform.w / 2 - agent.width / 2)) / agent.runSpeed;
+    }
+
+    //       rise  :     
+    bool JumpTimes(float rise, float& upTime, float& downTime) const {
+        float v = agent.jumpImpulse;
+        float discriminant = v * v - 2.0f * agent.gravity * rise;
+        if (discriminant < 0) return false;
+        upTime = (v - std::sqrt(discriminant)) / agent.gravity;
+        downTime = (v + std::sqrt(discriminant)) / agent.gravity;
+        return true;
+    }
+
+    void AddWalkOrJump(int from, int to) {
+        const SDL_FRect& a = platforms[from];
+        const SDL_FRect& b = platforms[to];
+        float rise = a.y - b.y;  // > 0 -  
+        bool overlapX = a.x < b.x + b.w && b.x < a.x + a.w;
+
+        // :   ,  
+        if (std::abs(rise) <= WALK_GAP && !overlapX) {
+            float gap = b.x >= a.x + a.w ? b.x - (a.x + a.w) : a.x - (b.x + b.w);
+            if (gap <= WALK_GAP) {
+                float takeoff = b.x >= a.x ? a.x + a.w - agent.width : a.x;
+                float landing = ClampOnto(b, b.x >= a.x ? b.x : b.x + b.w - agent.width);
+                edges.push_back({ from, to, NavEdgeType::Walk, takeoff, landing,
+                    WalkTime(a, takeoff) + std::abs(landing - takeoff) / agent.runSpeed });
+                return;
+            }
+        }
+
+        if (rise > JumpHeight() - HEIGHT_MARGIN) return;
+
+        float takeoff, landing;
+        if (overlapX) {
+            //     -  ,   
+            if (rise <= 0) return;
+
+            //    :    ,     
+            float rightTakeoff = b.x + b.w + TAKEOFF_CLEARANCE;
+            float leftTakeoff = b.x - agent.width - TAKEOFF_CLEARANCE;
+            bool rightFits = rightTakeoff + agent.width <= a.x + a.w;
+            bool leftFits = leftTakeoff >= a.x;
+            if (!rightFits && !leftFits) return;
+
+            float center = a.x + a.w / 2;
+            bool useRight = rightFits && (!leftFits || std::abs(rightTakeoff - center) <= std::abs(leftTakeoff - center));
+            takeoff = useRight ? rightTakeoff : leftTakeoff;
+            landing = ClampOnto(b, useRight ? b.x + b.w - agent.width : b.x);
+        }
+        else if (b.x >= a.x + a.w) {
+            takeoff = a.x + a.w - agent.width;
+            landing = ClampOnto(b, b.x);
+        }
+        else {
+            takeoff = a.x;
+            landing = ClampOnto(b, b.x + b.w - agent.width);
+        }
+
+        float upTime, airTime;
+        if (!JumpTimes(rise, upTime, airTime)) return;
+
+        //      ,     :
+        //     ,  -   upTime
+        float travel = std::abs(landing - takeoff);
+        float freeTravel = 0.0f;
+        if (rise > 0 && !overlapX) freeTravel = landing > takeoff ? b.x - (takeoff + agent.width) : takeoff - (b.x + b.w);
+        freeTravel = std::clamp(freeTravel, 0.0f, travel);
+        float flightTime = rise > 0 ? std::max(freeTravel / agent.runSpeed, upTime) + (travel - freeTravel) / agent.runSpeed
+                                    : travel / agent.runSpeed;
+        if (flightTime > airTime * JUMP_MARGIN) return;
+
+        edges.push_back({ from, to, NavEdgeType::Jump, takeoff, landing, WalkTime(a, takeoff) + airTime });
+    }
+
+    //      :       
+    void AddFall(int from, bool rightEdge) {
+        const SDL_FRect& a = platforms[from];
+        float columnX = rightEdge ? a.x + a.w : a.x - agent.width;
+
+        int best = -1;
+        for (int to = 0; to < NodeCount(); to++) {
+            const SDL_FRect& b = platforms[to];
+            if (to == from || b.y <= a.y) continue;
+            if (b.x >= columnX + agent.width || b.x + b.w <= columnX) continue;
+            if (best < 0 || b.y < platforms[best].y) best = to;
+        }
+        if (best < 0) return;
+
+        const SDL_FRect& b = platforms[best];
+        float drop = b.y - a.y;
+        float takeoff = rightEdge ? a.x + a.w - agent.width : a.x;
+        float landing = ClampOnto(b, columnX);
+        float fallTime = std::sqrt(2.0f * drop / agent.gravity);
+
+        edges.push_back({ from, best, NavEdgeType::Fall, takeoff, landing,
+            WalkTime(a, takeoff) + std::abs(landing - takeoff) / agent.runSpeed + fallTime });
+    }
+};
+
+//     :    -     .
+//     , ,     .
+class NavFlowField {
+public:
+    std::vector<float> cost;
+    std::vector<int> nextEdge;
+    std::vector<int> goals;
+    uint64_t recomputeCount = 0;
+
+    // newGoals - ,    ;  true,   
+    bool Update(const NavGraph& graph, const std::vector<int>& newGoals) {
+        candidateGoals.assign(newGoals.begin(), newGoals.end());
+        std::sort(candidateGoals.begin(), candidateGoals.end());
+        candidateGoals.erase(std::unique(candidateGoals.begin(), candidateGoals.end()), candidateGoals.end());
+        if (candidateGoals.empty()) return false;
+        if (candidateGoals == goals && cost.size() == static_cast<size_t>(graph.NodeCount())) return false;
+
+        goals.swap(candidateGoals);
+        Compute(graph);
+        recomputeCount++;
+        return true;
+    }
+
+    bool IsValid() const {
+        return !goals.empty();
+    }
+
+    bool IsGoal(int node) const {
+        return std::binary_search(goals.begin(), goals.end(), node);
+    }
+
+    // -1,   -       
+    int NextEdge(int node) const {
+        if (node < 0 || node >= static_cast<int>(nextEdge.size())) return -1;
+        return nextEdge[node];
+    }
+
+private:
+    std::vector<int> candidateGoals;
+
+    //        
+    void Compute(const NavGraph& graph) {
+        int count = graph.NodeCount();
+        cost.assign(count, std::numeric_limits<float>::infinity());
+        nextEdge.assign(count, -1);
+
+        typedef std::pair<float, int> QueueItem;
+        std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> open;
+        for (int goal : goals) {
+            if (goal < 0 || goal >= count) continue;
+            cost[goal] = 0.0f;
+            open.push({ 0.0f, goal });
+        }
+
+        while (!open.empty()) {
+            QueueItem item = open.top();
+            open.pop();
+            int node = item.second;
+            if (item.first > cost[node]) continue;
+
+            for (int i = graph.incomingStart[node]; i < graph.incomingStart[node + 1]; i++) {
+                int edgeIndex = graph.incoming[i];
+                const NavEdge& edge = graph.edges[edgeIndex];
+                float candidate = cost[node] + edge.cost;
+                if (candidate < cost[edge.from]) {
+                    cost[edge.from] = candidate;
+                    nextEdge[edge.from] = edgeIndex;
+                    open.push({ candidate, edge.from });
+                }
+            }
+        }
+    }
+};
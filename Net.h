@@ -0,0 +1,220 @@
+#pragma once
+//      (Winsock / BSD)
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef SOCKET SocketHandle;
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef int SocketHandle;
+#ifndef INVALID_SOCKET
+#define INVALID_SOCKET (-1)
+#endif
+#endif
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+inline bool NetInit() {
+#ifdef _WIN32
+    static bool initialized = false;
+    if (!initialized) {
+        WSADATA data;
+        if (WSAStartup(MAKEWORD(2, 2), &data) != 0) return false;
+        initialized = true;
+    }
+#endif
+    return true;
+}
+
+inline void CloseSocket(SocketHandle socket) {
+    if (socket == INVALID_SOCKET) return;
+#ifdef _WIN32
+    closesocket(socket);
+#else
+    close(socket);
+#endif
+}
+
+inline bool SetNonBlocking(SocketHandle socket) {
+#ifdef _WIN32
+    u_long mode = 1;
+    return ioctlsocket(socket, FIONBIO, &mode) == 0;
+#else
+    int flags = fcntl(socket, F_GETFL, 0);
+    return flags >= 0 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+}
+
+// ,      (  )
+inline bool WaitReadable(SocketHandle socket, int timeoutMs) {
+    fd_set readSet;
+    FD_ZERO(&readSet);
+    FD_SET(socket, &readSet);
+    timeval timeout = { timeoutMs / 1000, (timeoutMs % 1000) * 1000 };
+    return select(static_cast<int>(socket) + 1, &readSet, nullptr, nullptr, &timeout) > 0;
+}
+
+//  IPv4   ;     -  false
+inline bool MakeAddress(const std::string& host, uint16_t port, sockaddr_in& address) {
+    address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    return inet_pton(AF_INET, host.c_str(), &address.sin_addr) == 1;
+}
+
+// TCP-,   localhost
+class TcpListener {
+public:
+    SocketHandle socket;
+    uint16_t port;
+
+    TcpListener() {
+        socket = INVALID_SOCKET;
+        port = 0;
+    }
+
+    ~TcpListener() {
+        Close();
+    }
+
+    TcpListener(const TcpListener&) = delete;
+    TcpListener& operator=(const TcpListener&) = delete;
+
+    bool Open(uint16_t listenPort) {
+        Close();
+        if (!NetInit()) return false;
+
+        socket = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (socket == INVALID_SOCKET) return false;
+
+#ifndef _WIN32
+        //  Windows SO_REUSEADDR      
+        int reuse = 1;
+        setsockopt(socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+#endif
+
+        sockaddr_in address;
+        MakeAddress("127.0.0.1", listenPort, address);
+        if (bind(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            listen(socket, 8) != 0) {
+            Close();
+            return false;
+        }
+
+        port = listenPort;
+        return true;
+    }
+
+    //  INVALID_SOCKET,   timeoutMs   
+    SocketHandle Accept(int timeoutMs) {
+        if (socket == INVALID_SOCKET || !WaitReadable(socket, timeoutMs)) return INVALID_SOCKET;
+        return accept(socket, nullptr, nullptr);
+    }
+
+    void Close() {
+        CloseSocket(socket);
+        socket = INVALID_SOCKET;
+    }
+};
+
+//  UDP-
+class UdpSocket {
+public:
+    SocketHandle socket;
+
+    UdpSocket() {
+        socket = INVALID_SOCKET;
+    }
+
+    ~UdpSocket() {
+        Close();
+    }
+
+    UdpSocket(const UdpSocket&) = delete;
+    UdpSocket& operator=(const UdpSocket&) = delete;
+
+    // port 0 -    ( )
+    bool Open(const std::string& host, uint16_t port) {
+        Close();
+        if (!NetInit()) return false;
+
+        socket = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (socket == INVALID_SOCKET) return false;
+
+        //  ,       
+        int bufferSize = 4 * 1024 * 1024;
+        setsockopt(socket, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&bufferSize), sizeof(bufferSize));
+        setsockopt(socket, SOL_SOCKET, SO_SNDBUF, reinterpret_cast<const char*>(&bufferSize), sizeof(bufferSize));
+
+#ifdef _WIN32
+        //  ICMP " "       
+        BOOL reportReset = FALSE;
+        DWORD returned = 0;
+        WSAIoctl(socket, _WSAIOW(IOC_VENDOR, 12), &reportReset, sizeof(reportReset),
+            nullptr, 0, &returned, nullptr, nullptr);
+#endif
+
+        sockaddr_in address;
+        if (!MakeAddress(host, port, address) ||
+            bind(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || !SetNonBlocking(socket)) {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    uint16_t LocalPort() const {
+        sockaddr_in address = {};
+        socklen_t length = sizeof(address);
+        if (getsockname(socket, reinterpret_cast<sockaddr*>(&address), &length) != 0) return 0;
+        return ntohs(address.sin_port);
+    }
+
+    bool SendTo(const void* data, size_t size, const sockaddr_in& to) const {
+        return sendto(socket, static_cast<const char*>(data), static_cast<int>(size), 0,
+            reinterpret_cast<const sockaddr*>(&to), sizeof(to)) == static_cast<int>(size);
+    }
+
+    //     -1,   
+    int ReceiveFrom(void* buffer, size_t capacity, sockaddr_in& from) const {
+        socklen_t length = sizeof(from);
+        int received = recvfrom(socket, static_cast<char*>(buffer), static_cast<int>(capacity), 0,
+            reinterpret_cast<sockaddr*>(&from), &length);
+        return received;
+    }
+
+    void Close() {
+        CloseSocket(socket);
+        socket = INVALID_SOCKET;
+    }
+};
+
+inline bool SameAddress(const sockaddr_in& a, const sockaddr_in& b) {
+    return a.sin_addr.s_addr == b.sin_addr.s_addr && a.sin_port == b.sin_port;
+}
+
+// "host:port"   "host";      port
+inline void ParseHostPort(const std::string& text, std::string& host, uint16_t& port) {
+    size_t colon = text.rfind(':');
+    if (colon == std::string::npos) {
+        host = text;
+        return;
+    }
+    host = text.substr(0, colon);
+    int parsed = std::atoi(text.c_str() + colon + 1);
+    if (parsed > 0 && parsed < 65536) port = static_cast<uint16_t>(parsed);
+}
@@ -0,0 +1,224 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLES_USE_SSE 1
+#endif
+
+#include "ThreadPool.h"
+
+//       (SoA)   .
+//       [0, count):   
+//  ,      SDL_RenderGeometry.
+class ParticleSystem {
+public:
+    float GRAVITY = 600.0f;
+    float FADE_TIME = 0.3f;            //      
+    size_t PARALLEL_THRESHOLD = 32768; //       
+    size_t PARALLEL_GRAIN = 16384;
+
+    ParticleSystem(size_t maxParticles) {
+        capacity = maxParticles;
+        count = 0;
+        randomState = 0x9E3779B9u;
+
+        posX.resize(capacity);
+        posY.resize(capacity);
+        velX.resize(capacity);
+        velY.resize(capacity);
+        life.resize(capacity);
+        color.resize(capacity);
+    }
+
+    size_t Count() const {
+        return count;
+    }
+
+    size_t Capacity() const {
+        return capacity;
+    }
+
+    void Clear() {
+        count = 0;
+    }
+
+    //   ,    
+    void Emit(float x, float y, float vx, float vy, float lifetime, SDL_Color particleColor) {
+        if (count >= capacity) return;
+
+        posX[count] = x;
+        posY[count] = y;
+        velX[count] = vx;
+        velY[count] = vy;
+        life[count] = lifetime;
+        color[count] = particleColor;
+        count++;
+    }
+
+    //          speed
+    void EmitBurst(float x, float y, int amount, float speed, float lifetime, SDL_Color particleColor) {
+        for (int i = 0; i < amount; i++) {
+            float dirX = RandomFloat() * 2.0f - 1.0f;
+            float dirY = RandomFloat() * 2.0f - 1.0f;
+            float power = speed * (0.3f + 0.7f * RandomFloat());
+            float length = std::max(std::abs(dirX) + std::abs(dirY), 0.001f);
+
+            Emit(x, y, dirX / length * power, dirY / length * power - speed * 0.5f,
+                lifetime * (0.5f + 0.5f * RandomFloat()), particleColor);
+        }
+    }
+
+    // pool :   (    )  
+    void Update(float deltaTime, ThreadPool* pool = nullptr) {
+        if (count == 0) return;
+
+        if (pool == nullptr || pool->Size() == 1 || count < PARALLEL_THRESHOLD) {
+            Integrate(0, count, deltaTime);
+            count = Compact(0, count);
+            return;
+        }
+
+        //     ,      
+        size_t chunks = (count + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN;
+        chunkAlive.assign(chunks, 0);
+        pool->ParallelFor(count, PARALLEL_GRAIN, [this, deltaTime](size_t begin, size_t end) {
+            Integrate(begin, end, deltaTime);
+            chunkAlive[begin / PARALLEL_GRAIN] = Compact(begin, end) - begin;
+        });
+
+        size_t write = chunkAlive[0];
+        for (size_t chunk = 1; chunk < chunks; chunk++) {
+            MoveRange(chunk * PARALLEL_GRAIN, write, chunkAlive[chunk]);
+            write += chunkAlive[chunk];
+        }
+        count = write;
+    }
+
+    //   -  size x size,      
+    void Render(SDL_Renderer* renderer, float cameraX, float cameraY, float size) {
+        if (count == 0) return;
+        BuildVertices(cameraX, cameraY, size);
+
+        //       ,    
+        SDL_BlendMode previousMode;
+        SDL_GetRenderDrawBlendMode(renderer, &previousMode);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        SDL_RenderGeometry(renderer, nullptr, vertices.data(), static_cast<int>(count * 4),
+            indices.data(), static_cast<int>(count * 6));
+        SDL_SetRenderDrawBlendMode(renderer, previousMode);
+    }
+
+    //     Render; ,    
+    void BuildVertices(float cameraX, float cameraY, float size) {
+        vertices.resize(count * 4);
+        if (indices.size() < count * 6) {
+            size_t first = indices.size() / 6;
+            indices.resize(count * 6);
+            for (size_t i = first; i < count; i++) {
+                int base = static_cast<int>(i * 4);
+                int* quad = &indices[i * 6];
+                quad[0] = base; quad[1] = base + 1; quad[2] = base + 2;
+                quad[3] = base + 2; quad[4] = base + 3; quad[5] = base;
+            }
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            float left = posX[i] - cameraX;
+            float top = posY[i] - cameraY;
+            SDL_Color c = color[i];
+            c.a = static_cast<Uint8>(c.a * std::min(life[i] / FADE_TIME, 1.0f));
+
+            SDL_Vertex* quad = &vertices[i * 4];
+            quad[0] = { { left, top }, c, { 0.0f, 0.0f } };
+            quad[1] = { { left + size, top }, c, { 0.0f, 0.0f } };
+            quad[2] = { { left + size, top + size }, c, { 0.0f, 0.0f } };
+            quad[3] = { { left, top + size }, c, { 0.0f, 0.0f } };
+        }
+    }
+
+private:
+    size_t capacity;
+    size_t count;
+    uint32_t randomState;
+
+    std::vector<float> posX, posY;
+    std::vector<float> velX, velY;
+    std::vector<float> life;
+    std::vector<SDL_Color> color;
+
+    std::vector<size_t> chunkAlive;
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+
+    float RandomFloat() {
+        // xorshift32:      
+        randomState ^= randomState << 13;
+        randomState ^= randomState >> 17;
+        randomState ^= randomState << 5;
+        return (randomState >> 8) * (1.0f / 16777216.0f);
+    }
+
+    //  ,   Player:  ,  
+    void Integrate(size_t begin, size_t end, float deltaTime) {
+        size_t i = begin;
+        float gravityStep = GRAVITY * deltaTime;
+
+#ifdef PARTICLES_USE_SSE
+        __m128 dt = _mm_set1_ps(deltaTime);
+        __m128 gravity = _mm_set1_ps(gravityStep);
+        for (; i + 4 <= end; i += 4) {
+            __m128 vx = _mm_loadu_ps(&velX[i]);
+            __m128 vy = _mm_add_ps(_mm_loadu_ps(&velY[i]), gravity);
+            __m128 px = _mm_add_ps(_mm_loadu_ps(&posX[i]), _mm_mul_ps(vx, dt));
+            __m128 py = _mm_add_ps(_mm_loadu_ps(&posY[i]), _mm_mul_ps(vy, dt));
+            __m128 remaining = _mm_sub_ps(_mm_loadu_ps(&life[i]), dt);
+
+            _mm_storeu_ps(&velY[i], vy);
+            _mm_storeu_ps(&posX[i], px);
+            _mm_storeu_ps(&posY[i], py);
+            _mm_storeu_ps(&life[i], remaining);
+        }
+#endif
+
+        for (; i < end; i++) {
+            velY[i] += gravityStep;
+            posX[i] += velX[i] * deltaTime;
+            posY[i] += velY[i] * deltaTime;
+            life[i] -= deltaTime;
+        }
+    }
+
+    //    [begin, end)   ,   
+    size_t Compact(size_t begin, size_t end) {
+        size_t write = begin;
+        while (write < end && life[write] > 0.0f) write++;
+
+        for (size_t read = write + 1; read < end; read++) {
+            if (life[read] <= 0.0f) continue;
+            posX[write] = posX[read];
+            posY[write] = posY[read];
+            velX[write] = velX[read];
+            velY[write] = velY[read];
+            life[write] = life[read];
+            color[write] = color[read];
+            write++;
+        }
+        return write;
+    }
+
+    void MoveRange(size_t from, size_t to, size_t amount) {
+        if (from == to || amount == 0) return;
+        std::memmove(&posX[to], &posX[from], amount * sizeof(float));
+        std::memmove(&posY[to], &posY[from], amount * sizeof(float));
+        std::memmove(&velX[to], &velX[from], amount * sizeof(float));
+        std::memmove(&velY[to], &velY[from], amount * sizeof(float));
+        std::memmove(&life[to], &life[from], amount * sizeof(float));
+        std::memmove(&color[to], &color[from], amount * sizeof(SDL_Color));
+    }
+};
@@ -5,299 +5,517 @@
 #include <sstream>
 #include <cctype>
 #include <string>
-
-class Coin {
-public:
-    float x, y;
-    float width, height;
-    bool isCollected;
-
-    Coin(float posX, float posY) {
-        x = posX;
-        y = posY;
-        width = 20;
-        height = 20;
-        isCollected = false;
+#include <chrono>
+#include <cstdlib>
+#include <csignal>
+#include <atomic>
+#include <random>
+
+#include "FramePacer.h"
+#include "GameObjects.h"
+#include "Level.h"
+#include "Metrics.h"
+#include "Particles.h"
+#include "RoomClient.h"
+#include "RoomServer.h"
+#include "UpdateScheduler.h"
+
+// PlatformerGame --bench-behaviors [count]:      
+int RunBehaviorBenchmark(int enemyCount) {
+    std::vector<Enemy> crowd;
+    crowd.reserve(enemyCount);
+    for (int i = 0; i < enemyCount; i++) {
+        crowd.emplace_back(static_cast<float>((i % 1000) * 300), static_cast<float>((i / 1000) * 300), 100.0f);
     }
 
-    SDL_FRect GetRect() const {
-        return { x, y, width, height };
+    BehaviorScheduler scheduler;
+    size_t framesBefore = BehaviorTask::frameBytes;
+    for (int i = 0; i < enemyCount; i++) {
+        if (i % 4 == 0) {
+            scheduler.Spawn(SentryBehavior(crowd[i], scheduler, 200.0f));
+        }
+        else {
+            scheduler.Spawn(PatrolBehavior(crowd[i], 0.5f + (i % 7) * 0.25f));
+        }
     }
 
-    //     
-    bool CheckCollision(const SDL_FRect& playerRect) const {
-        if (isCollected) return false;
+    //    ,   
+    std::vector<SDL_FPoint> targets = { { 0.0f, 0.0f } };
+    scheduler.Tick(0.0f, targets);  //        
 
-        return (x < playerRect.x + playerRect.w &&
-            x + width > playerRect.x &&
-            y < playerRect.y + playerRect.h &&
-            y + height > playerRect.y);
-    }
+    size_t frameBytes = BehaviorTask::frameBytes - framesBefore;
+    size_t schedulerBytes = scheduler.MemoryBytes();
+
+    const int TICKS = 600;
+    const float DELTA_TIME = 1.0f / 60.0f;
+    double tickSeconds = 0.0;
+    size_t resumes = 0;
+    for (int tick = 0; tick < TICKS; tick++) {
+        targets[0].x += 400.0f * DELTA_TIME;
 
-    void Collect() {
-        isCollected = true;
+        auto start = std::chrono::steady_clock::now();
+        scheduler.Tick(DELTA_TIME, targets);
+        tickSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        resumes += scheduler.ResumedLastTick();
+
+        for (auto& enemy : crowd) enemy.Update(DELTA_TIME);
     }
-};
-
-class Player {
-public:
-    float x, y;          // 
-    float width, height; // 
-    float velocityX, velocityY; // 
-    bool isOnGround;     //   
-    bool canSprint;
-    int lives;
-    int coinsCollected;
-    bool isAlive;
-    float invincibilityTimer;
-
-    float NORMAL_SPEED = 200.0f;
-    float SPRINT_SPEED = 350.0f;
-    float INVINCIBILITY_TIME = 2.0f;
-
-    Player(float startX, float startY) {
-        x = startX;
-        y = startY;
-        width = 50;
-        height = 50;
-        velocityX = 0;
-        velocityY = 0;
-        isOnGround = false;
-        canSprint = true;
-        coinsCollected = 0;
-        lives = 3;
-        isAlive = true;
-        invincibilityTimer = 0.0f;
+
+    std::cout << "Behavior benchmark: " << enemyCount << " enemies, " << TICKS << " ticks" << std::endl;
+    std::cout << "  coroutine frames: " << frameBytes / enemyCount << " bytes/enemy" << std::endl;
+    std::cout << "  scheduler:        " << schedulerBytes / enemyCount << " bytes/enemy" << std::endl;
+    std::cout << "  Tick:             " << tickSeconds / TICKS * 1e6 << " us/tick, "
+        << resumes / TICKS << " resumes/tick" << std::endl;
+    std::cout << "  resume cost:      " << (resumes ? tickSeconds / resumes * 1e9 : 0.0) << " ns/resume" << std::endl;
+    return 0;
+}
+
+// PlatformerGame --bench-particles [count]:  (   )   
+int RunParticleBenchmark(int particleCount) {
+    ParticleSystem particles(particleCount);
+    ThreadPool pool(std::max(0, static_cast<int>(std::thread::hardware_concurrency()) - 1));
+    const SDL_Color gold = { 255, 215, 0, 255 };
+
+    const int TICKS = 600;
+    const float DELTA_TIME = 1.0f / 60.0f;
+    double updateSeconds[2] = { 0.0, 0.0 };
+    double vertexSeconds = 0.0;
+    size_t live = 0;
+
+    //      ,    
+    for (int pass = 0; pass < 2; pass++) {
+        particles.Clear();
+        for (int tick = 0; tick < TICKS; tick++) {
+            particles.EmitBurst(400.0f, 300.0f, static_cast<int>(particles.Capacity() - particles.Count()), 300.0f, 1.5f, gold);
+            live += particles.Count();
+
+            auto start = std::chrono::steady_clock::now();
+            particles.Update(DELTA_TIME, pass == 0 ? nullptr : &pool);
+            auto updated = std::chrono::steady_clock::now();
+            updateSeconds[pass] += std::chrono::duration<double>(updated - start).count();
+
+            if (pass == 0) {
+                particles.BuildVertices(0.0f, 0.0f, 3.0f);
+                vertexSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - updated).count();
+            }
+        }
     }
 
-    //  bounding box 
-    SDL_FRect GetRect() const {
-        return { x, y, width, height };
+    std::cout << "Particle benchmark: " << particleCount << " capacity, " << live / (TICKS * 2) << " live on average, "
+        << TICKS << " ticks" << std::endl;
+    std::cout << "  Update, 1 thread:  " << updateSeconds[0] / TICKS * 1e6 << " us/tick" << std::endl;
+    std::cout << "  Update, " << pool.Size() << " threads: " << updateSeconds[1] / TICKS * 1e6 << " us/tick" << std::endl;
+    std::cout << "  vertex build:      " << vertexSeconds / TICKS * 1e6 << " us/tick" << std::endl;
+    return 0;
+}
+
+// PlatformerGame --bench-lod [count]:       LOD
+int RunLodBenchmark(int entityCount) {
+    std::vector<Enemy> crowd;
+    crowd.reserve(entityCount);
+    std::mt19937 random(12345);
+    for (int i = 0; i < entityCount; i++) {
+        crowd.emplace_back(static_cast<float>(random() % 200000), static_cast<float>(random() % 2000), 100.0f);
     }
 
-    //     
-    bool CheckCollision(const SDL_FRect& other) const {
-        SDL_FRect rect = GetRect();
-        return (rect.x < other.x + other.w &&
-            rect.x + rect.w > other.x &&
-            rect.y < other.y + other.h &&
-            rect.y + rect.h > other.y);
+    UpdateScheduler scheduler;
+    scheduler.FROZEN_RADIUS = 50000.0f;
+    SDL_FPoint focus = { 100000.0f, 1000.0f };
+
+    const int TICKS = 600;
+    const float DELTA_TIME = 1.0f / 60.0f;
+    auto position = [&crowd](size_t i) { return SDL_FPoint{ crowd[i].x, crowd[i].y }; };
+    auto update = [&crowd](size_t i, float deltaTime) { crowd[i].Update(deltaTime); };
+
+    //    - ,    
+    size_t farMin = SIZE_MAX, farMax = 0, checkedMin = SIZE_MAX, checkedMax = 0, deferredMax = 0;
+    double totalUs = 0.0, maxUs = 0.0;
+    int measured = 0;
+    for (int tick = 0; tick < TICKS; tick++) {
+        focus.x += 300.0f * DELTA_TIME;
+        scheduler.Run(crowd.size(), focus, DELTA_TIME, position, update);
+        if (tick < scheduler.FROZEN_INTERVAL) continue;
+
+        const LodStats& stats = scheduler.GetStats();
+        farMin = std::min(farMin, stats.farUpdated);
+        farMax = std::max(farMax, stats.farUpdated);
+        checkedMin = std::min(checkedMin, stats.frozenChecked);
+        checkedMax = std::max(checkedMax, stats.frozenChecked);
+        deferredMax = std::max(deferredMax, stats.farDeferred);
+        totalUs += stats.elapsedUs;
+        maxUs = std::max(maxUs, stats.elapsedUs);
+        measured++;
     }
 
-    //  
-    void ResolveCollision(const SDL_FRect& platform) {
-        SDL_FRect rect = GetRect();
-
-        //      
-        float overlapLeft = (rect.x + rect.w) - platform.x;    //  
-        float overlapRight = (platform.x + platform.w) - rect.x; //  
-        float overlapTop = (rect.y + rect.h) - platform.y;     //  
-        float overlapBottom = (platform.y + platform.h) - rect.y; //  
-
-        //   
-        float minOverlap = std::min({ overlapLeft, overlapRight, overlapTop, overlapBottom });
-
-        //     
-        if (minOverlap == overlapTop && velocityY > 0) {
-            //   (   )
-            y = platform.y - height;
-            velocityY = 0;
-            isOnGround = true;
-        }
-        else if (minOverlap == overlapBottom && velocityY < 0) {
-            //   (  )
-            y = platform.y + platform.h;
-            velocityY = 0;
-        }
-        else if (minOverlap == overlapLeft) {
-            //  
-            x = platform.x - width;
-            velocityX = 0;
-        }
-        else if (minOverlap == overlapRight) {
-            //  
-            x = platform.x + platform.w;
-            velocityX = 0;
+    //   :    2     3000 px/s.   NEAR_RADIUS
+    //      NearIndices    ;  ,    
+    UpdateScheduler jumpy;
+    jumpy.FROZEN_RADIUS = scheduler.FROZEN_RADIUS;
+    focus = { 100000.0f, 1000.0f };
+    std::vector<uint8_t> isNear(entityCount, 0);
+    std::vector<int> waiting(entityCount, 0);
+    int maxLatency = 0;
+    size_t lateFrames = 0, promoted = 0;
+    double jumpMaxUs = 0.0;
+    for (int tick = 0; tick < TICKS; tick++) {
+        if (tick % 120 == 119) {
+            focus = { static_cast<float>(20000 + random() % 160000), static_cast<float>(random() % 2000) };
+        }
+        else {
+            focus.x += (tick % 120 >= 60 && tick % 120 < 70 ? 3000.0f : 300.0f) * DELTA_TIME;
         }
+        jumpy.Run(crowd.size(), focus, DELTA_TIME, position, update);
+        promoted += jumpy.GetStats().promoted;
+        jumpMaxUs = std::max(jumpMaxUs, jumpy.GetStats().elapsedUs);
+
+        for (uint32_t index : jumpy.NearIndices()) isNear[index] = 1;
+        for (int i = 0; i < entityCount; i++) {
+            float dx = crowd[i].x - focus.x, dy = crowd[i].y - focus.y;
+            bool inside = dx * dx + dy * dy <= jumpy.NEAR_RADIUS * jumpy.NEAR_RADIUS;
+            waiting[i] = inside && !isNear[i] ? waiting[i] + 1 : 0;
+            if (waiting[i] > 0) lateFrames++;
+            maxLatency = std::max(maxLatency, waiting[i]);
+        }
+        for (uint32_t index : jumpy.NearIndices()) isNear[index] = 0;
     }
 
-    void Update(float deltaTime, const std::vector<SDL_FRect>& platforms) {
-        //   
-        if (invincibilityTimer > 0) {
-            invincibilityTimer -= deltaTime;
-        }
+    const LodStats& last = scheduler.GetStats();
+    std::cout << "LOD benchmark: " << entityCount << " entities, " << TICKS << " ticks" << std::endl;
+    std::cout << "  last frame:     " << last.nearUpdated << " near, " << last.frozen << " frozen" << std::endl;
+    std::cout << "  far/frame:      min " << (measured ? farMin : 0) << ", max " << farMax
+        << ", deferred max " << deferredMax << std::endl;
+    std::cout << "  frozen checks:  min " << (measured ? checkedMin : 0) << ", max " << checkedMax << " per frame" << std::endl;
+    std::cout << "  Run:            " << (measured ? totalUs / measured : 0.0) << " us/frame avg, " << maxUs << " us max" << std::endl;
+    std::cout << "  teleports:      promotion latency max " << maxLatency << " frames, " << lateFrames
+        << " late entity-frames, " << promoted << " promoted early, " << jumpMaxUs << " us max Run" << std::endl;
+    return 0;
+}
+
+// PlatformerGame --bench-pursuers [count]:  ,    
+int RunPursuitBenchmark(int pursuerCount) {
+    Level level = LoadDefaultLevel();
+    std::vector<Enemy> pursuers;
+    pursuers.reserve(pursuerCount);
+    BehaviorScheduler scheduler;
+    NavFlowField flow;
+    for (int i = 0; i < pursuerCount; i++) {
+        pursuers.emplace_back(600.0f + (i % 150), 540.0f, 0.0f);
+        pursuers.back().usesPhysics = true;
+        scheduler.Spawn(PursueBehavior(pursuers.back(), scheduler, level.navigation, flow));
+    }
 
-        //  
-        if (!isOnGround) {
-            velocityY += 1000.0f * deltaTime; // 
+    //      ,      
+    Player player(300, 100);
+    player.logEvents = false;
+    std::vector<SDL_FPoint> targets(1);
+    std::vector<int> goals(1);
+
+    const int TICKS = 600;
+    const float DELTA_TIME = 1.0f / 60.0f;
+    double fieldSeconds = 0.0, simulationSeconds = 0.0;
+    for (int tick = 0; tick < TICKS; tick++) {
+        player.Update(DELTA_TIME, level.collision);
+
+        auto start = std::chrono::steady_clock::now();
+        if (player.contacts.ground >= 0) {
+            goals[0] = player.contacts.ground;
+            flow.Update(level.navigation, goals);
         }
-        
-        canSprint = isOnGround;
+        auto fieldDone = std::chrono::steady_clock::now();
 
-        //     Y  ,     
-        float oldY = y;
+        targets[0] = { player.x + player.width / 2, player.y + player.height / 2 };
+        scheduler.Tick(DELTA_TIME, targets);
+        for (auto& pursuer : pursuers) pursuer.Update(DELTA_TIME, level.collision);
 
-        //    X
-        x += velocityX * deltaTime;
+        fieldSeconds += std::chrono::duration<double>(fieldDone - start).count();
+        simulationSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - fieldDone).count();
+    }
 
-        //    X
-        SDL_FRect playerRect = GetRect();
-        for (const auto& platform : platforms) {
-            if (CheckCollision(platform)) {
-                ResolveCollision(platform);
-                break;
-            }
-        }
+    int arrived = 0;
+    uint64_t queries = 0;
+    for (const auto& pursuer : pursuers) {
+        if (pursuer.contacts.ground == player.contacts.ground) arrived++;
+        queries += pursuer.contacts.queryCount;
+    }
 
-        //    Y
-        y += velocityY * deltaTime;
+    //   :     
+    const int RECOMPUTES = 1000;
+    NavFlowField recomputed;
+    auto recomputeStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < RECOMPUTES; i++) {
+        goals[0] = i % 2;
+        recomputed.Update(level.navigation, goals);
+    }
+    double recomputeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - recomputeStart).count();
+
+    std::cout << "Pursuit benchmark: " << pursuerCount << " pursuers, " << TICKS << " ticks, "
+        << level.navigation.NodeCount() << " nodes, " << level.navigation.edges.size() << " edges" << std::endl;
+    std::cout << "  flow field:         " << fieldSeconds / TICKS * 1e6 << " us/tick, "
+        << flow.recomputeCount << " recomputes" << std::endl;
+    std::cout << "  field recompute:    " << recomputeSeconds / RECOMPUTES * 1e6 << " us" << std::endl;
+    std::cout << "  behaviors+physics:  " << simulationSeconds / TICKS * 1e6 << " us/tick" << std::endl;
+    std::cout << "  broadphase queries: " << static_cast<double>(queries) / TICKS << " /tick" << std::endl;
+    std::cout << "  arrived:            " << arrived << "/" << pursuerCount << " on the player's platform" << std::endl;
+    return 0;
+}
+
+static std::atomic<bool> serverRunning(true);
+
+static void StopServer(int) {
+    serverRunning = false;
+}
+
+// PlatformerGame --server [port] [rooms] [threads]:    
+int RunServer(uint16_t port, int roomCount, int threadCount) {
+    Level level = LoadDefaultLevel();
+
+    MetricsRegistry metrics;
+    RoomServer server(level, roomCount, threadCount, metrics);
+    if (!server.Open("0.0.0.0", port)) {
+        std::cerr << "Server: cannot bind UDP port " << port << std::endl;
+        return 1;
+    }
 
-        //    Y
-        playerRect = GetRect();
-        bool wasOnGround = isOnGround; //   
-        isOnGround = false; //   
+    MetricsExporter metricsExporter(metrics, 9465, "server_metrics.prom", 10);
+    metricsExporter.Start();
 
-        for (const auto& platform : platforms) {
-            if (CheckCollision(platform)) {
-                ResolveCollision(platform);
-            }
-        }
+    std::signal(SIGINT, StopServer);
+    std::signal(SIGTERM, StopServer);
 
-        //  :     ,         
-        if (!isOnGround && std::abs(velocityY) < 1.0f) {
-            SDL_FRect feetRect = { x, y + height - 1, width, 2 }; //   
-            for (const auto& platform : platforms) {
-                if (feetRect.y < platform.y + platform.h &&
-                    feetRect.y + feetRect.h > platform.y &&
-                    feetRect.x < platform.x + platform.w &&
-                    feetRect.x + feetRect.w > platform.x) {
-                    isOnGround = true;
-                    break;
-                }
-            }
-        }
-        //    (  )
-        if (y > 600) {
-            TakeDamage();
-        }
-        if (x < 0) x = 0;
-        if (x > 800 - width) x = 800 - width; 
+    std::cout << "Server: " << server.RoomCount() << " rooms on UDP port " << server.Port()
+        << ", " << server.ThreadCount() << " threads" << std::endl;
+    server.Run(serverRunning);
 
+    metricsExporter.Stop();
+    std::cout << "Server stopped. Tick p50/p99: " << server.tickTime.Quantile(0.5) / 1e6 << " / "
+        << server.tickTime.Quantile(0.99) / 1e6 << " ms" << std::endl;
+    return 0;
+}
 
+typedef void (*DrawCharFunction)(SDL_Renderer*, char, int, int);
+
+//  :    ,   -    
+void RunClient(SDL_Renderer* renderer, const Level& level, FramePacer& pacer,
+    const std::string& host, uint16_t port, uint16_t room, DrawCharFunction drawChar) {
+    UdpSocket socket;
+    if (!socket.Open("0.0.0.0", 0)) {
+        std::cerr << "Client: cannot open UDP socket" << std::endl;
+        return;
     }
-    //    
-    void TakeDamage() {
-        if (invincibilityTimer > 0 || !isAlive) return;
 
-        lives--;
-        invincibilityTimer = INVINCIBILITY_TIME;
+    sockaddr_in serverAddress;
+    if (!MakeAddress(host, port, serverAddress)) {
+        std::cerr << "Client: " << host << " is not an IPv4 address" << std::endl;
+        return;
+    }
 
-        std::cout << "Player hit! Lives: " << lives << std::endl;
+    std::random_device random;
+    RoomClient client(random() | 1u, room, serverAddress);
+    std::cout << "Connecting to " << host << ":" << port << ", room " << room << "..." << std::endl;
 
-        if (lives <= 0) {
-            isAlive = false;
-            std::cout << "Game Over!" << std::endl;
-        }
-        else {
-            //    
-            x = 100;
-            y = 100;
-            velocityX = 0;
-            velocityY = 0;
-        }
-    }
+    const Uint8* keyboardState = SDL_GetKeyboardState(NULL);
+    const Player playerShape(0, 0);
+    const Enemy enemyShape(0, 0);
+    const std::vector<Coin> coinShapes = level.CreateCoins();
+    SDL_Rect camera = { 0, 0, 800, 600 };
 
-    //     ( )
-    bool IsInvincible() const {
-        return invincibilityTimer > 0;
-    }
+    bool running = true;
+    float helloTimer = 0.0f;
+    float connectTime = 0.0f;
+    uint8_t buffer[MAX_PACKET_SIZE];
+
+    while (running) {
+        float deltaTime = pacer.BeginFrame();
 
-    void Jump() {
-        if (isOnGround) {
-            velocityY = -500.0f; //  
-            isOnGround = false;
+        SDL_Event event;
+        while (SDL_PollEvent(&event)) {
+            if (event.type == SDL_QUIT ||
+                (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_ESCAPE)) {
+                running = false;
+            }
         }
-    }
 
-    void MoveLeft(bool isSprinting = false) {
-        if (isSprinting && canSprint) {
-            velocityX = -SPRINT_SPEED;
+        //  ,     
+        sockaddr_in from;
+        int size;
+        while ((size = socket.ReceiveFrom(buffer, sizeof(buffer), from)) > 0) {
+            PacketReader in(buffer, static_cast<size_t>(size));
+            uint8_t type;
+            uint32_t clientId;
+            if (SameAddress(from, client.server) && ReadPacketHeader(in, type, clientId) && clientId == client.clientId) {
+                client.HandlePacket(type, in);
+            }
         }
-        else {
-            velocityX = -NORMAL_SPEED;
+
+        if (client.isRejected) {
+            std::cerr << "Client: room " << room << " is full or does not exist" << std::endl;
+            break;
         }
-    }
 
-    void MoveRight(bool isSprinting = false) {
-        if (isSprinting && canSprint) {
-            velocityX = SPRINT_SPEED;
+        if (!client.isConnected) {
+            connectTime += deltaTime;
+            helloTimer -= deltaTime;
+            if (helloTimer <= 0) {
+                client.SendHello(socket);
+                helloTimer = 0.5f;
+            }
+            if (connectTime > 5.0f) {
+                std::cerr << "Client: no answer from server" << std::endl;
+                break;
+            }
         }
         else {
-            velocityX = NORMAL_SPEED;
+            uint8_t buttons = 0;
+            if (keyboardState[SDL_SCANCODE_A]) buttons |= BUTTON_LEFT;
+            else if (keyboardState[SDL_SCANCODE_D]) buttons |= BUTTON_RIGHT;
+            if (keyboardState[SDL_SCANCODE_LSHIFT]) buttons |= BUTTON_SPRINT;
+            if (keyboardState[SDL_SCANCODE_SPACE]) buttons |= BUTTON_JUMP;  //    
+            client.SendInput(socket, buttons);
         }
-    }
+        pacer.MarkInputSampled();
 
-    void Stop() {
-        velocityX = 0;
-    }
+        SDL_SetRenderDrawColor(renderer, 68, 51, 85, 255);
+        SDL_RenderClear(renderer);
 
-    void CollectCoin() {
-        coinsCollected++;
-        std::cout << "Coin collected! Total: " << coinsCollected << std::endl;
-    }
-};
-
-class Enemy {
-public:
-    float x, y;
-    float width, height;
-    float velocityX;
-    float patrolDistance;
-    float startX;
-    bool isActive;
-
-    Enemy(float posX, float posY, float patrolDist = 100.0f) {
-        x = posX;
-        y = posY;
-        width = 40;
-        height = 40;
-        velocityX = 50.0f;
-        patrolDistance = patrolDist;
-        startX = posX;
-        isActive = true;
-    }
+        if (client.isConnected && client.latestTick != 0) {
+            const float scale = static_cast<float>(SnapshotLayout::POSITION_SCALE);
+            const int32_t* self = client.PlayerValues(client.slot);
 
-    SDL_FRect GetRect() const {
-        return { x, y, width, height };
-    }
+            //     
+            camera.x = static_cast<int>(self[0] / scale + playerShape.width / 2 - 400);
+            camera.y = static_cast<int>(self[1] / scale + playerShape.height / 2 - 300);
+            camera.x = std::clamp(camera.x, 0, 1600 - camera.w);
+            camera.y = std::clamp(camera.y, 0, 1200 - camera.h);
 
-    void Update(float deltaTime) {
-        if (!isActive) return;
+            SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
+            for (const auto& platform : level.platforms) {
+                SDL_FRect platformScreenRect = { platform.x - camera.x, platform.y - camera.y, platform.w, platform.h };
+                SDL_RenderFillRectF(renderer, &platformScreenRect);
+            }
 
-        //  -
-        x += velocityX * deltaTime;
+            SDL_SetRenderDrawColor(renderer, 255, 215, 0, 255);
+            for (int i = 0; i < client.layout.coinCount && i < static_cast<int>(coinShapes.size()); i++) {
+                if (client.IsCoinCollected(i)) continue;
+                const Coin& coin = coinShapes[i];
+                SDL_FRect coinScreenRect = { coin.x - camera.x, coin.y - camera.y, coin.width, coin.height };
+                SDL_RenderFillRectF(renderer, &coinScreenRect);
+            }
 
-        //     
-        if (x > startX + patrolDistance) {
-            velocityX = -abs(velocityX);
-        }
-        else if (x < startX - patrolDistance) {
-            velocityX = abs(velocityX);
+            for (int i = 0; i < client.layout.enemyCount; i++) {
+                const int32_t* enemy = client.EnemyValues(i);
+                if (!enemy[2]) continue;
+                float enemyX = enemy[0] / scale - camera.x;
+                float enemyY = enemy[1] / scale - camera.y;
+
+                SDL_FRect enemyScreenRect = { enemyX, enemyY, enemyShape.width, enemyShape.height };
+                SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
+                SDL_RenderFillRectF(renderer, &enemyScreenRect);
+
+                SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+                SDL_FRect leftEye = { enemyX + 8, enemyY + 10, 8, 8 };
+                SDL_FRect rightEye = { enemyX + 24, enemyY + 10, 8, 8 };
+                SDL_RenderFillRectF(renderer, &leftEye);
+                SDL_RenderFillRectF(renderer, &rightEye);
+            }
+
+            //   ,  ;       
+            for (int i = 0; i < client.layout.maxPlayers; i++) {
+                const int32_t* values = client.PlayerValues(i);
+                int flags = values[4];
+                if (!(flags & SnapshotLayout::PLAYER_CONNECTED) || !(flags & SnapshotLayout::PLAYER_ALIVE)) continue;
+                if (values[5] > 0 && (values[5] / 100) % 2 == 1) continue;
+
+                SDL_FRect playerScreenRect = {
+                    values[0] / scale - camera.x,
+                    values[1] / scale - camera.y,
+                    playerShape.width,
+                    playerShape.height
+                };
+                if (i == client.slot) SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
+                else SDL_SetRenderDrawColor(renderer, 60, 120, 255, 255);
+                SDL_RenderFillRectF(renderer, &playerScreenRect);
+            }
+
+            //  
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 128);
+            SDL_Rect scoreBackground = { 10, 10, 150, 40 };
+            SDL_RenderFillRect(renderer, &scoreBackground);
+
+            SDL_SetRenderDrawColor(renderer, 255, 215, 0, 255);
+            SDL_Rect coinIcon = { 20, 20, 15, 15 };
+            SDL_RenderFillRect(renderer, &coinIcon);
+
+            SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+            char scoreText[50];
+            sprintf_s(scoreText, "%d / %d", self[3], client.layout.coinCount);
+            int textX = 40;
+            for (int i = 0; scoreText[i] != '\0'; i++) {
+                drawChar(renderer, scoreText[i], textX, 22);
+                textX += (scoreText[i] == ' ') ? 6 : 10;
+            }
+
+            std::string livesText = "LIVES:";
+            int livesTextX = 20;
+            for (char c : livesText) {
+                drawChar(renderer, c, livesTextX, 55);
+                livesTextX += 10;
+            }
+
+            SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
+            for (int i = 0; i < self[2]; i++) {
+                SDL_Rect heart = { 70 + i * 25, 55, 20, 20 };
+                SDL_RenderFillRect(renderer, &heart);
+            }
         }
-    }
 
-    //    
-    bool CheckCollision(const SDL_FRect& playerRect) const {
-        if (!isActive) return false;
+        pacer.BeginPresent();
+        SDL_RenderPresent(renderer);
+        pacer.EndPresent();
+    }
 
-        return (x < playerRect.x + playerRect.w &&
-            x + width > playerRect.x &&
-            y < playerRect.y + playerRect.h &&
-            y + height > playerRect.y);
+    if (client.isConnected) {
+        client.SendLeave(socket);
+        std::cout << "Client: " << client.snapshotsReceived << " snapshots, "
+            << client.decodeFailures << " decode failures, "
+            << client.bytesReceived / 1024 << " KB received" << std::endl;
     }
-};
+}
 
 int main(int argc, char* argv[]) {
+    if (argc >= 2 && std::string(argv[1]) == "--bench-behaviors") {
+        return RunBehaviorBenchmark(argc >= 3 ? std::max(1, std::atoi(argv[2])) : 100000);
+    }
+    if (argc >= 2 && std::string(argv[1]) == "--bench-particles") {
+        return RunParticleBenchmark(argc >= 3 ? std::max(1, std::atoi(argv[2])) : 131072);
+    }
+    if (argc >= 2 && std::string(argv[1]) == "--bench-lod") {
+        return RunLodBenchmark(argc >= 3 ? std::max(1, std::atoi(argv[2])) : 100000);
+    }
+    if (argc >= 2 && std::string(argv[1]) == "--bench-pursuers") {
+        return RunPursuitBenchmark(argc >= 3 ? std::max(1, std::atoi(argv[2])) : 10000);
+    }
+    if (argc >= 2 && std::string(argv[1]) == "--server") {
+        uint16_t port = argc >= 3 ? static_cast<uint16_t>(std::atoi(argv[2])) : DEFAULT_SERVER_PORT;
+        int roomCount = argc >= 4 ? std::max(1, std::atoi(argv[3])) : 64;
+        int threadCount = argc >= 5 ? std::max(1, std::atoi(argv[4])) : static_cast<int>(std::thread::hardware_concurrency());
+        return RunServer(port, roomCount, std::max(1, threadCount));
+    }
+
+    // PlatformerGame --connect host[:port] [room]:      
+    std::string connectHost;
+    uint16_t connectPort = DEFAULT_SERVER_PORT;
+    uint16_t connectRoom = 0;
+    if (argc >= 3 && std::string(argv[1]) == "--connect") {
+        ParseHostPort(argv[2], connectHost, connectPort);
+        if (argc >= 4) connectRoom = static_cast<uint16_t>(std::atoi(argv[3]));
+
+        sockaddr_in serverAddress;
+        if (!MakeAddress(connectHost, connectPort, serverAddress)) {
+            std::cerr << "--connect: " << connectHost << " is not an IPv4 address (host names are not resolved)" << std::endl;
+            return 1;
+        }
+    }
+
     std::cout << "Starting Platformer Game with SDL2..." << std::endl;
 
     //  SDL
@@ -330,44 +548,87 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    //     ,   
+    Level level = LoadDefaultLevel();
+    const std::vector<SDL_FRect>& platforms = level.platforms;
+    const CollisionWorld& collisionWorld = level.collision;
+
     //  
     Player player(100, 100);
-
-    std::vector<Coin> coins = {
-    Coin(250, 350),  //    
-    Coin(150, 250),  //      
-    Coin(550, 200),  //    
-    Coin(75, 450),   //  
-    Coin(675, 400)   //   
-    };
-
-    std::vector<Enemy> enemies = {
-    Enemy(300, 350, 150),  //    
-    Enemy(150, 250, 80),   //     
-    Enemy(550, 200, 100),  //     
-    Enemy(50, 450, 50)     //    
-    };
+    std::vector<Coin> coins = level.CreateCoins();
+    std::vector<Enemy> enemies = level.CreateEnemies();
+
+    //   - ;  enemies     
+    BehaviorScheduler behaviors;
+    std::vector<SDL_FPoint> behaviorTargets(1);
+    NavFlowField pursuitField;           //    
+    std::vector<int> pursuitGoals(1);
+    level.StartBehaviors(enemies, behaviors, pursuitField);
+
+    //  :    ,      .
+    //          FAR_INTERVAL .
+    UpdateScheduler enemyLod;
+    UpdateScheduler coinLod;
+    coinLod.NEAR_RADIUS = 300.0f;
+    coinLod.FROZEN_RADIUS = 1200.0f;
+    coinLod.BUDGET_US = 250.0;
 
     SDL_Rect camera = { 0, 0, 800, 600 };
 
-    //   (x, y, width, height)
-    std::vector<SDL_FRect> platforms = {
-        {200.0f, 400.0f, 400.0f, 20.0f},  //  
-        {100.0f, 300.0f, 200.0f, 20.0f},  //  
-        {500.0f, 250.0f, 200.0f, 20.0f},  //  
-        {0.0f, 580.0f, 800.0f, 20.0f},    // 
-        {50.0f, 500.0f, 100.0f, 20.0f},   //  
-        {650.0f, 450.0f, 100.0f, 20.0f}   //  
-    };
-
     std::cout << "Game started! Use A/D to move, SPACE to jump, ESC to exit." << std::endl;
 
     //   
     bool running = true;
     int frameCount = 0;
-    Uint32 lastTime = SDL_GetTicks();
     const Uint8* keyboardState = SDL_GetKeyboardState(NULL);
 
+    //    ,     Present
+    SDL_DisplayMode displayMode;
+    double refreshRate = 60.0;
+    if (SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(window), &displayMode) == 0 &&
+        displayMode.refresh_rate > 0) {
+        refreshRate = displayMode.refresh_rate;
+    }
+    FramePacer pacer(refreshRate);
+
+    //   :  metrics.prom  http://127.0.0.1:9464/metrics
+    MetricsRegistry metrics;
+    LatencyHistogram& frameTimeMetric = metrics.AddHistogram("platformer_frame_time_seconds",
+        "Time between two presented frames");
+    LatencyHistogram& simTimeMetric = metrics.AddHistogram("platformer_sim_tick_seconds",
+        "Time spent in one simulation step");
+    LatencyHistogram& renderTimeMetric = metrics.AddHistogram("platformer_render_seconds",
+        "Time spent issuing draw calls for one frame");
+    LatencyHistogram& presentWaitMetric = metrics.AddHistogram("platformer_present_wait_seconds",
+        "Time blocked in SDL_RenderPresent");
+    MetricCounter& framesCounter = metrics.AddCounter("platformer_frames_total",
+        "Frames presented");
+    MetricCounter& simulatedCounter = metrics.AddCounter("platformer_entities_simulated_total",
+        "Entities updated or collision-tested by the simulation");
+    MetricCounter& drawnCounter = metrics.AddCounter("platformer_entities_drawn_total",
+        "Entities submitted for drawing");
+    MetricCounter& lodNearCounter = metrics.AddCounter("platformer_lod_near_updates_total",
+        "Enemy and coin updates in the every-frame LOD tier");
+    MetricCounter& lodFarCounter = metrics.AddCounter("platformer_lod_far_updates_total",
+        "Enemy and coin updates in the time-sliced far LOD tier");
+    MetricCounter& lodDeferredCounter = metrics.AddCounter("platformer_lod_deferred_total",
+        "Far updates carried over to the next frame by the LOD budget");
+    MetricCounter& lodFrozenCounter = metrics.AddCounter("platformer_lod_frozen_total",
+        "Enemy and coin skips beyond the frozen LOD radius");
+    MetricsExporter metricsExporter(metrics, 9464, "metrics.prom", 10);
+    metricsExporter.Start();
+
+    //       ;       
+    ThreadPool workerPool(std::max(0, static_cast<int>(std::thread::hardware_concurrency()) - 1));
+    ParticleSystem particles(131072);
+    const SDL_Color coinParticleColor = { 255, 215, 0, 255 };
+    const SDL_Color damageParticleColor = { 255, 60, 40, 255 };
+
+    const double nanosecondsPerTick = 1e9 / static_cast<double>(SDL_GetPerformanceFrequency());
+    auto ElapsedNanoseconds = [nanosecondsPerTick](Uint64 start, Uint64 end) {
+        return static_cast<uint64_t>((end - start) * nanosecondsPerTick);
+    };
+
     //     
     auto DrawSimpleChar = [](SDL_Renderer* renderer, char c, int x, int y) {
         //      
@@ -576,10 +837,14 @@ int main(int argc, char* argv[]) {
 
         };
 
+    if (!connectHost.empty()) {
+        RunClient(renderer, level, pacer, connectHost, connectPort, connectRoom, DrawSimpleChar);
+        running = false;
+    }
+
     while (running) {
-        Uint32 currentTime = SDL_GetTicks();
-        float deltaTime = (currentTime - lastTime) / 1000.0f;
-        lastTime = currentTime;
+        //    ,      
+        float deltaTime = pacer.BeginFrame();
 
 
 
@@ -613,7 +878,9 @@ int main(int argc, char* argv[]) {
 
             
 
+            pacer.BeginPresent();
             SDL_RenderPresent(renderer);
+            pacer.EndPresent();
             
 
             //  
@@ -626,17 +893,19 @@ int main(int argc, char* argv[]) {
                 if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_r) {
                     //  
                     player = Player(100, 100);
+                    particles.Clear();
                     for (auto& coin : coins) {
                         coin.isCollected = false;
                     }
                     for (auto& enemy : enemies) {
-                        enemy.isActive = true;
-                        enemy.x = enemy.startX;
+                        enemy.Reset();
                     }
+                    level.StartBehaviors(enemies, behaviors, pursuitField);
+                    enemyLod.Clear();
+                    coinLod.Clear();
                 }
             }
 
-            SDL_Delay(16);
             continue;
         }
 
@@ -647,7 +916,14 @@ int main(int argc, char* argv[]) {
         if (coinDisplayCounter % 60 == 0) {
             std::cout << "Coins: " << player.coinsCollected << "/" << coins.size()
                 << " | Lives: " << player.lives
-                << " | Invincible: " << (player.IsInvincible() ? "Yes" : "No") << std::endl;
+                << " | Invincible: " << (player.IsInvincible() ? "Yes" : "No")
+                << " | Latency: " << pacer.GetStats().inputToPresentMs << " ms"
+                << " | Jitter: " << pacer.GetStats().averageJitterMs << " ms" << std::endl;
+
+            const LodStats& enemyStats = enemyLod.GetStats();
+            std::cout << "LOD enemies: near " << enemyStats.nearUpdated << ", far " << enemyStats.farUpdated
+                << " (+" << enemyStats.farDeferred << " deferred), frozen " << enemyStats.frozen
+                << ", " << enemyStats.elapsedUs << " us" << std::endl;
         }
 
         //  
@@ -676,28 +952,56 @@ int main(int argc, char* argv[]) {
                 player.Stop();
             }
         }
+        pacer.MarkInputSampled();
+        Uint64 simStart = SDL_GetPerformanceCounter();
+
+        // ,   :      
+        int livesBeforeStep = player.lives;
+        SDL_FPoint hitPoint = { player.x + player.width / 2, player.y + player.height / 2 };
 
         //    
-        player.Update(deltaTime, platforms);
+        player.Update(deltaTime, collisionWorld);
 
         //    (   playerRect)
         SDL_FRect playerRect = player.GetRect();
-        for (auto& coin : coins) {
-            if (coin.CheckCollision(playerRect)) {
-                coin.Collect();
-                player.CollectCoin();
-            }
-        } 
+        SDL_FPoint playerCenter = { player.x + player.width / 2, player.y + player.height / 2 };
+        coinLod.Run(coins.size(), playerCenter, deltaTime,
+            [&coins](size_t i) { return SDL_FPoint{ coins[i].x, coins[i].y }; },
+            [&](size_t i, float) {
+                Coin& coin = coins[i];
+                if (coin.CheckCollision(playerRect)) {
+                    coin.Collect();
+                    player.CollectCoin();
+                    particles.EmitBurst(coin.x + coin.width / 2, coin.y + coin.height / 2,
+                        48, 250.0f, 0.8f, coinParticleColor);
+                }
+            });
 
-        //  
-        for (auto& enemy : enemies) {
-            enemy.Update(deltaTime);
+        //   ,       
+        if (player.contacts.ground >= 0) {
+            pursuitGoals[0] = player.contacts.ground;
+            pursuitField.Update(level.navigation, pursuitGoals);
         }
 
-        //    
+        //  :    ,  
+        behaviorTargets[0] = playerCenter;
+        behaviors.Tick(deltaTime, behaviorTargets);
+        enemyLod.Run(enemies.size(), playerCenter, deltaTime,
+            [&enemies](size_t i) { return SDL_FPoint{ enemies[i].x, enemies[i].y }; },
+            [&enemies, &collisionWorld](size_t i, float enemyDeltaTime) { enemies[i].Update(enemyDeltaTime, collisionWorld); });
+
+        const LodStats& enemyStats = enemyLod.GetStats();
+        const LodStats& coinStats = coinLod.GetStats();
+        lodNearCounter.Add(enemyStats.nearUpdated + coinStats.nearUpdated);
+        lodFarCounter.Add(enemyStats.farUpdated + coinStats.farUpdated);
+        lodDeferredCounter.Add(enemyStats.farDeferred + coinStats.farDeferred);
+        lodFrozenCounter.Add(enemyStats.frozen + coinStats.frozen);
+
+        //    :       
         if (player.isAlive && !player.IsInvincible()) {
             SDL_FRect playerRect = player.GetRect();
-            for (auto& enemy : enemies) {
+            for (uint32_t index : enemyLod.NearIndices()) {
+                const Enemy& enemy = enemies[index];
                 if (enemy.CheckCollision(playerRect)) {
                     player.TakeDamage();
                     break; //        
@@ -705,6 +1009,15 @@ int main(int argc, char* argv[]) {
             }
         }
 
+        if (player.lives < livesBeforeStep) {
+            particles.EmitBurst(hitPoint.x, hitPoint.y, 96, 350.0f, 1.0f, damageParticleColor);
+        }
+        particles.Update(deltaTime, &workerPool);
+        Uint64 simEnd = SDL_GetPerformanceCounter();
+        simTimeMetric.Record(ElapsedNanoseconds(simStart, simEnd));
+        simulatedCounter.Add(1 + enemyStats.nearUpdated + enemyStats.farUpdated +
+            coinStats.nearUpdated + coinStats.farUpdated + particles.Count());
+
         //   (  )
         camera.x = static_cast<int>(player.x + player.width / 2 - 400);
         camera.y = static_cast<int>(player.y + player.height / 2 - 300);
@@ -716,6 +1029,8 @@ int main(int argc, char* argv[]) {
         if (camera.y > 1200 - camera.h) camera.y = 1200 - camera.h;
 
         //  
+        Uint64 renderStart = SDL_GetPerformanceCounter();
+        uint64_t drawnCount = platforms.size();
         SDL_SetRenderDrawColor(renderer, 68, 51, 85, 255);
         SDL_RenderClear(renderer);
 
@@ -742,6 +1057,7 @@ int main(int argc, char* argv[]) {
                     coin.height
                 };
                 SDL_RenderFillRectF(renderer, &coinScreenRect);
+                drawnCount++;
             }
         }
 
@@ -766,6 +1082,7 @@ int main(int argc, char* argv[]) {
             SDL_FRect rightEye = { enemy.x - camera.x + 24, enemy.y - camera.y + 10, 8, 8 };
             SDL_RenderFillRectF(renderer, &leftEye);
             SDL_RenderFillRectF(renderer, &rightEye);
+            drawnCount++;
         }
 
         //   (  playerRect)
@@ -779,8 +1096,13 @@ int main(int argc, char* argv[]) {
         if (!player.IsInvincible() || (static_cast<int>(player.invincibilityTimer * 10) % 2 == 0)) {
             SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
             SDL_RenderFillRectF(renderer, &playerScreenRect);
+            drawnCount++;
         }
 
+        //     
+        particles.Render(renderer, static_cast<float>(camera.x), static_cast<float>(camera.y), 4.0f);
+        drawnCount += particles.Count();
+
 
         //       
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 128);
@@ -826,14 +1148,22 @@ int main(int argc, char* argv[]) {
         }
 
         //  
+        pacer.BeginPresent();
+        renderTimeMetric.Record(ElapsedNanoseconds(renderStart, SDL_GetPerformanceCounter()));
         SDL_RenderPresent(renderer);
+        pacer.EndPresent();
 
-
-
-        SDL_Delay(16);
+        const FrameStats& frameStats = pacer.GetStats();
+        if (frameStats.frameTimeMs > 0.0) {
+            frameTimeMetric.Record(static_cast<uint64_t>(frameStats.frameTimeMs * 1e6));
+        }
+        presentWaitMetric.Record(static_cast<uint64_t>(frameStats.presentWaitMs * 1e6));
+        framesCounter.Add(1);
+        drawnCounter.Add(drawnCount);
     }
 
             //  
+            metricsExporter.Stop();
             SDL_DestroyRenderer(renderer);
             SDL_DestroyWindow(window);
             SDL_Quit();
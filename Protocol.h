@@ -0,0 +1,225 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+//   .   little-endian,     
+//   ,      .
+//
+//   HELLO    -> : room(u16)
+//   WELCOME  -> : room(u16) slot(u8) maxPlayers(u8) enemies(u16) coins(u16)
+//   INPUT    -> : sequence(u32) ackTick(u32) buttons(u8)
+//   STATE    -> : tick(u32) baselineTick(u32)  
+//   LEAVE    -> 
+//   REJECT   -> :     
+enum PacketType : uint8_t {
+    PACKET_HELLO = 1,
+    PACKET_WELCOME = 2,
+    PACKET_INPUT = 3,
+    PACKET_STATE = 4,
+    PACKET_LEAVE = 5,
+    PACKET_REJECT = 6
+};
+
+enum InputButtons : uint8_t {
+    BUTTON_LEFT = 1,
+    BUTTON_RIGHT = 2,
+    BUTTON_SPRINT = 4,
+    BUTTON_JUMP = 8
+};
+
+const int MAX_PACKET_SIZE = 1400;
+const uint16_t DEFAULT_SERVER_PORT = 27960;
+
+class PacketWriter {
+public:
+    uint8_t data[MAX_PACKET_SIZE];
+    size_t size = 0;
+    bool overflow = false;
+
+    void WriteU8(uint8_t value) {
+        if (size + 1 > sizeof(data)) {
+            overflow = true;
+            return;
+        }
+        data[size++] = value;
+    }
+
+    void WriteU16(uint16_t value) {
+        WriteU8(static_cast<uint8_t>(value));
+        WriteU8(static_cast<uint8_t>(value >> 8));
+    }
+
+    void WriteU32(uint32_t value) {
+        WriteU16(static_cast<uint16_t>(value));
+        WriteU16(static_cast<uint16_t>(value >> 16));
+    }
+
+    // 7   :     
+    void WriteVarUint(uint32_t value) {
+        while (value >= 0x80) {
+            WriteU8(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        WriteU8(static_cast<uint8_t>(value));
+    }
+
+    // Zigzag: -1 -> 1, 1 -> 2,       
+    void WriteVarInt(int32_t value) {
+        WriteVarUint((static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31));
+    }
+};
+
+class PacketReader {
+public:
+    const uint8_t* data;
+    size_t size;
+    size_t position = 0;
+    bool failed = false;
+
+    PacketReader(const uint8_t* packet, size_t packetSize) : data(packet), size(packetSize) {}
+
+    uint8_t ReadU8() {
+        if (position >= size) {
+            failed = true;
+            return 0;
+        }
+        return data[position++];
+    }
+
+    uint16_t ReadU16() {
+        uint16_t low = ReadU8();
+        return static_cast<uint16_t>(low | (ReadU8() << 8));
+    }
+
+    uint32_t ReadU32() {
+        uint32_t low = ReadU16();
+        return low | (static_cast<uint32_t>(ReadU16()) << 16);
+    }
+
+    uint32_t ReadVarUint() {
+        uint32_t value = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            uint8_t byte = ReadU8();
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) return value;
+        }
+        failed = true;
+        return 0;
+    }
+
+    int32_t ReadVarInt() {
+        uint32_t value = ReadVarUint();
+        return static_cast<int32_t>((value >> 1) ^ (0u - (value & 1)));
+    }
+};
+
+//   :   int32,     
+struct SnapshotLayout {
+    static const int PLAYER_FIELDS = 6;  // x, y ( 1/4 ), , , ,  ()
+    static const int ENEMY_FIELDS = 3;   // x, y ( 1/4 ), 
+    static const int POSITION_SCALE = 4;
+
+    enum PlayerFlags {
+        PLAYER_CONNECTED = 1,
+        PLAYER_ALIVE = 2
+    };
+
+    int maxPlayers = 0;
+    int enemyCount = 0;
+    int coinCount = 0;
+
+    int PlayerBase(int slot) const {
+        return slot * PLAYER_FIELDS;
+    }
+
+    int EnemyBase(int index) const {
+        return maxPlayers * PLAYER_FIELDS + index * ENEMY_FIELDS;
+    }
+
+    //   -    32   
+    int CoinWordBase() const {
+        return EnemyBase(enemyCount);
+    }
+
+    int ValueCount() const {
+        return CoinWordBase() + (coinCount + 31) / 32;
+    }
+};
+
+// -    ( ,   ).
+//   8  - - ,   zigzag- .
+inline void EncodeDelta(const std::vector<int32_t>& current, const std::vector<int32_t>* baseline, PacketWriter& out) {
+    size_t count = current.size();
+    for (size_t group = 0; group < count; group += 8) {
+        size_t end = group + 8 < count ? group + 8 : count;
+
+        uint8_t mask = 0;
+        for (size_t i = group; i < end; i++) {
+            int32_t base = baseline ? (*baseline)[i] : 0;
+            if (current[i] != base) mask |= static_cast<uint8_t>(1 << (i - group));
+        }
+
+        out.WriteU8(mask);
+        for (size_t i = group; i < end; i++) {
+            if (mask & (1 << (i - group))) {
+                int32_t base = baseline ? (*baseline)[i] : 0;
+                out.WriteVarInt(static_cast<int32_t>(static_cast<uint32_t>(current[i]) - static_cast<uint32_t>(base)));
+            }
+        }
+    }
+}
+
+inline bool DecodeDelta(PacketReader& in, const std::vector<int32_t>* baseline, std::vector<int32_t>& result, size_t count) {
+    if (baseline && baseline->size() != count) return false;
+
+    result.resize(count);
+    for (size_t group = 0; group < count; group += 8) {
+        size_t end = group + 8 < count ? group + 8 : count;
+        uint8_t mask = in.ReadU8();
+        for (size_t i = group; i < end; i++) {
+            int32_t base = baseline ? (*baseline)[i] : 0;
+            if (mask & (1 << (i - group))) {
+                result[i] = static_cast<int32_t>(static_cast<uint32_t>(base) + static_cast<uint32_t>(in.ReadVarInt()));
+            }
+            else {
+                result[i] = base;
+            }
+        }
+    }
+    return !in.failed;
+}
+
+//   :          ,
+//  -       
+class SnapshotHistory {
+public:
+    static const int CAPACITY = 64;
+
+    void Store(uint32_t tick, const std::vector<int32_t>& values) {
+        Entry& entry = entries[tick % CAPACITY];
+        entry.tick = tick;
+        entry.values = values;
+    }
+
+    const std::vector<int32_t>* Find(uint32_t tick) const {
+        if (tick == 0) return nullptr;
+        const Entry& entry = entries[tick % CAPACITY];
+        return entry.tick == tick ? &entry.values : nullptr;
+    }
+
+private:
+    struct Entry {
+        uint32_t tick = 0;
+        std::vector<int32_t> values;
+    };
+
+    Entry entries[CAPACITY];
+};
+
+//         
+inline bool ReadPacketHeader(PacketReader& in, uint8_t& type, uint32_t& clientId) {
+    type = in.ReadU8();
+    clientId = in.ReadU32();
+    return !in.failed;
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <vector>
+
+#include "Net.h"
+#include "Protocol.h"
+
+//        :    
+//       UdpSocket.
+class RoomClient {
+public:
+    uint32_t clientId;
+    uint16_t room;
+    sockaddr_in server;
+
+    bool isConnected = false;
+    bool isRejected = false;
+    int slot = -1;
+    SnapshotLayout layout;
+
+    uint32_t latestTick = 0;
+    std::vector<int32_t> snapshot;   //   
+
+    uint64_t snapshotsReceived = 0;
+    uint64_t decodeFailures = 0;
+    uint64_t bytesReceived = 0;
+
+    RoomClient(uint32_t id, uint16_t roomId, const sockaddr_in& serverAddress) {
+        clientId = id;
+        room = roomId;
+        server = serverAddress;
+    }
+
+    void SendHello(const UdpSocket& socket) const {
+        PacketWriter packet;
+        packet.WriteU8(PACKET_HELLO);
+        packet.WriteU32(clientId);
+        packet.WriteU16(room);
+        socket.SendTo(packet.data, packet.size, server);
+    }
+
+    //    -   ,     
+    void SendInput(const UdpSocket& socket, uint8_t buttons) {
+        PacketWriter packet;
+        packet.WriteU8(PACKET_INPUT);
+        packet.WriteU32(clientId);
+        packet.WriteU32(++inputSequence);
+        packet.WriteU32(latestTick);
+        packet.WriteU8(buttons);
+        socket.SendTo(packet.data, packet.size, server);
+    }
+
+    void SendLeave(const UdpSocket& socket) const {
+        PacketWriter packet;
+        packet.WriteU8(PACKET_LEAVE);
+        packet.WriteU32(clientId);
+        socket.SendTo(packet.data, packet.size, server);
+    }
+
+    //        ; reader    
+    void HandlePacket(uint8_t type, PacketReader& in) {
+        bytesReceived += in.size;
+
+        if (type == PACKET_WELCOME) {
+            uint16_t welcomeRoom = in.ReadU16();
+            int welcomeSlot = in.ReadU8();
+            layout.maxPlayers = in.ReadU8();
+            layout.enemyCount = in.ReadU16();
+            layout.coinCount = in.ReadU16();
+            if (in.failed || welcomeRoom != room) return;
+
+            if (!isConnected) {
+                snapshot.assign(layout.ValueCount(), 0);
+                latestTick = 0;
+            }
+            slot = welcomeSlot;
+            isConnected = true;
+        }
+        else if (type == PACKET_REJECT) {
+            isRejected = true;
+        }
+        else if (type == PACKET_STATE && isConnected) {
+            uint32_t tick = in.ReadU32();
+            uint32_t baselineTick = in.ReadU32();
+            if (in.failed || tick <= latestTick) return;
+
+            //      -   ,    ack
+            const std::vector<int32_t>* baseline = nullptr;
+            if (baselineTick != 0) {
+                baseline = history.Find(baselineTick);
+                if (!baseline) {
+                    decodeFailures++;
+                    return;
+                }
+            }
+
+            if (!DecodeDelta(in, baseline, decoded, layout.ValueCount())) {
+                decodeFailures++;
+                return;
+            }
+
+            snapshot.swap(decoded);
+            latestTick = tick;
+            history.Store(tick, snapshot);
+            snapshotsReceived++;
+        }
+    }
+
+    const int32_t* PlayerValues(int playerSlot) const {
+        return &snapshot[layout.PlayerBase(playerSlot)];
+    }
+
+    const int32_t* EnemyValues(int index) const {
+        return &snapshot[layout.EnemyBase(index)];
+    }
+
+    bool IsCoinCollected(int index) const {
+        return (static_cast<uint32_t>(snapshot[layout.CoinWordBase() + index / 32]) >> (index % 32)) & 1u;
+    }
+
+private:
+    uint32_t inputSequence = 0;
+    std::vector<int32_t> decoded;
+    SnapshotHistory history;
+};
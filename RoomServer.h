@@ -0,0 +1,453 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "GameObjects.h"
+#include "Level.h"
+#include "Metrics.h"
+#include "Net.h"
+#include "Protocol.h"
+#include "ThreadPool.h"
+
+//  :  ,    ,  .
+//  ,     .
+class Room {
+public:
+    static const int MAX_PLAYERS = 4;
+    float RESPAWN_TIME = 3.0f;
+
+    struct Slot {
+        bool connected = false;
+        uint32_t clientId = 0;
+        sockaddr_in address = {};
+        uint8_t buttons = 0;
+        bool jumpPressed = false;
+        uint32_t lastInputSequence = 0;
+        uint32_t ackTick = 0;
+        double lastHeard = 0.0;
+        float respawnTimer = 0.0f;
+    };
+
+    int id;
+    const Level& level;
+    SnapshotLayout layout;
+    std::vector<Player> players;
+    std::vector<Slot> slots;
+    std::vector<Coin> coins;
+    std::vector<Enemy> enemies;
+    BehaviorScheduler behaviors;
+    uint32_t tick;
+
+    Room(int roomId, const Level& roomLevel) : level(roomLevel) {
+        id = roomId;
+        tick = 0;
+        coins = level.CreateCoins();
+        enemies = level.CreateEnemies();
+        level.StartBehaviors(enemies, behaviors, pursuitField);
+
+        layout.maxPlayers = MAX_PLAYERS;
+        layout.enemyCount = static_cast<int>(enemies.size());
+        layout.coinCount = static_cast<int>(coins.size());
+        snapshot.assign(layout.ValueCount(), 0);
+
+        slots.resize(MAX_PLAYERS);
+        for (int i = 0; i < MAX_PLAYERS; i++) {
+            players.push_back(Player(100, 100));
+            players.back().logEvents = false;
+        }
+    }
+
+    int Join(uint32_t clientId, const sockaddr_in& address, double now) {
+        for (int i = 0; i < MAX_PLAYERS; i++) {
+            if (slots[i].connected) continue;
+            slots[i] = Slot();
+            slots[i].connected = true;
+            slots[i].clientId = clientId;
+            slots[i].address = address;
+            slots[i].lastHeard = now;
+            ResetPlayer(i);
+            return i;
+        }
+        return -1;
+    }
+
+    void Leave(int slot) {
+        slots[slot].connected = false;
+    }
+
+    int ConnectedCount() const {
+        int count = 0;
+        for (const auto& slot : slots) count += slot.connected ? 1 : 0;
+        return count;
+    }
+
+    //     ;  -  ,    .
+    //         HELLO.
+    void ApplyInput(int slot, uint32_t sequence, uint32_t ackTick, uint8_t buttons, double now) {
+        Slot& state = slots[slot];
+        state.lastHeard = now;
+        if (sequence <= state.lastInputSequence) return;
+
+        if ((buttons & BUTTON_JUMP) && !(state.buttons & BUTTON_JUMP)) state.jumpPressed = true;
+        state.buttons = buttons;
+        state.lastInputSequence = sequence;
+        state.ackTick = std::max(state.ackTick, ackTick);
+    }
+
+    void Step(float deltaTime) {
+        if (ConnectedCount() == 0) return;
+        tick++;
+
+        targets.clear();
+        for (int i = 0; i < MAX_PLAYERS; i++) {
+            if (!slots[i].connected) continue;
+            Player& player = players[i];
+
+            if (!player.isAlive) {
+                slots[i].respawnTimer -= deltaTime;
+                if (slots[i].respawnTimer <= 0) ResetPlayer(i);
+                continue;
+            }
+
+            uint8_t buttons = slots[i].buttons;
+            bool isSprinting = (buttons & BUTTON_SPRINT) != 0;
+            if (buttons & BUTTON_LEFT) {
+                player.MoveLeft(isSprinting);
+            }
+            else if (buttons & BUTTON_RIGHT) {
+                player.MoveRight(isSprinting);
+            }
+            else {
+                player.Stop();
+            }
+            if (slots[i].jumpPressed) {
+                player.Jump();
+                slots[i].jumpPressed = false;
+            }
+
+            player.Update(deltaTime, level.collision);
+
+            //       
+            if (!player.isAlive) {
+                slots[i].respawnTimer = RESPAWN_TIME;
+                continue;
+            }
+
+            SDL_FRect playerRect = player.GetRect();
+            for (auto& coin : coins) {
+                if (coin.CheckCollision(playerRect)) {
+                    coin.Collect();
+                    player.CollectCoin();
+                }
+            }
+
+            targets.push_back({ player.x + player.width / 2, player.y + player.height / 2 });
+        }
+
+        //         
+        pursuitGoals.clear();
+        for (int i = 0; i < MAX_PLAYERS; i++) {
+            if (slots[i].connected && players[i].isAlive && players[i].contacts.ground >= 0) {
+                pursuitGoals.push_back(players[i].contacts.ground);
+            }
+        }
+        pursuitField.Update(level.navigation, pursuitGoals);
+
+        behaviors.Tick(deltaTime, targets);
+        for (auto& enemy : enemies) {
+            enemy.Update(deltaTime, level.collision);
+        }
+
+        for (int i = 0; i < MAX_PLAYERS; i++) {
+            Player& player = players[i];
+            if (!slots[i].connected || !player.isAlive || player.IsInvincible()) continue;
+
+            SDL_FRect playerRect = player.GetRect();
+            for (const auto& enemy : enemies) {
+                if (enemy.CheckCollision(playerRect)) {
+                    player.TakeDamage();
+                    if (!player.isAlive) slots[i].respawnTimer = RESPAWN_TIME;
+                    break;
+                }
+            }
+        }
+
+        //    -   
+        bool allCollected = !coins.empty();
+        for (const auto& coin : coins) allCollected = allCollected && coin.isCollected;
+        if (allCollected) {
+            for (auto& coin : coins) coin.isCollected = false;
+        }
+
+        BuildSnapshot();
+    }
+
+    //   -      
+    void SendStates(const UdpSocket& socket, MetricCounter& packetsSent, MetricCounter& bytesSent) {
+        if (ConnectedCount() == 0) return;
+
+        for (const auto& slot : slots) {
+            if (!slot.connected) continue;
+
+            const std::vector<int32_t>* baseline = history.Find(slot.ackTick);
+            PacketWriter packet;
+            packet.WriteU8(PACKET_STATE);
+            packet.WriteU32(slot.clientId);
+            packet.WriteU32(tick);
+            packet.WriteU32(baseline ? slot.ackTick : 0);
+            EncodeDelta(snapshot, baseline, packet);
+            if (packet.overflow) continue;
+
+            socket.SendTo(packet.data, packet.size, slot.address);
+            packetsSent.Add(1);
+            bytesSent.Add(packet.size);
+        }
+    }
+
+private:
+    std::vector<SDL_FPoint> targets;
+    NavFlowField pursuitField;
+    std::vector<int> pursuitGoals;
+    std::vector<int32_t> snapshot;
+    SnapshotHistory history;
+
+    void ResetPlayer(int slot) {
+        players[slot] = Player(100, 100);
+        players[slot].logEvents = false;
+        slots[slot].respawnTimer = 0.0f;
+    }
+
+    void BuildSnapshot() {
+        std::fill(snapshot.begin(), snapshot.end(), 0);
+
+        for (int i = 0; i < MAX_PLAYERS; i++) {
+            if (!slots[i].connected) continue;
+            const Player& player = players[i];
+            int32_t* values = &snapshot[layout.PlayerBase(i)];
+            values[0] = static_cast<int32_t>(player.x * SnapshotLayout::POSITION_SCALE);
+            values[1] = static_cast<int32_t>(player.y * SnapshotLayout::POSITION_SCALE);
+            values[2] = player.lives;
+            values[3] = player.coinsCollected;
+            values[4] = SnapshotLayout::PLAYER_CONNECTED | (player.isAlive ? SnapshotLayout::PLAYER_ALIVE : 0);
+            values[5] = static_cast<int32_t>(std::max(player.invincibilityTimer, 0.0f) * 1000);
+        }
+
+        for (int i = 0; i < layout.enemyCount; i++) {
+            const Enemy& enemy = enemies[i];
+            int32_t* values = &snapshot[layout.EnemyBase(i)];
+            values[0] = static_cast<int32_t>(enemy.x * SnapshotLayout::POSITION_SCALE);
+            values[1] = static_cast<int32_t>(enemy.y * SnapshotLayout::POSITION_SCALE);
+            values[2] = enemy.isActive ? 1 : 0;
+        }
+
+        for (int i = 0; i < layout.coinCount; i++) {
+            if (coins[i].isCollected) {
+                snapshot[layout.CoinWordBase() + i / 32] |= static_cast<int32_t>(1u << (i % 32));
+            }
+        }
+
+        history.Store(tick, snapshot);
+    }
+};
+
+//   :  ,  , UDP.
+//      ,     
+//    .
+class RoomServer {
+public:
+    float TICK_RATE = 60.0f;
+    double CLIENT_TIMEOUT = 5.0;
+
+    LatencyHistogram& tickTime;
+    LatencyHistogram& roomStepTime;
+    MetricCounter& packetsReceived;
+    MetricCounter& packetsSent;
+    MetricCounter& bytesSent;
+
+    RoomServer(const Level& serverLevel, int roomCount, int threadCount, MetricsRegistry& metrics)
+        : tickTime(metrics.AddHistogram("platformer_server_tick_seconds", "Wall time of one server tick over all rooms")),
+        roomStepTime(metrics.AddHistogram("platformer_room_step_seconds", "Simulation and send time of one room tick")),
+        packetsReceived(metrics.AddCounter("platformer_server_packets_received_total", "UDP packets received")),
+        packetsSent(metrics.AddCounter("platformer_server_packets_sent_total", "UDP packets sent")),
+        bytesSent(metrics.AddCounter("platformer_server_bytes_sent_total", "UDP payload bytes sent")),
+        level(serverLevel), pool(std::max(0, threadCount - 1)) {
+        for (int i = 0; i < roomCount; i++) {
+            rooms.push_back(std::make_unique<Room>(i, level));
+        }
+        startTime = std::chrono::steady_clock::now();
+    }
+
+    bool Open(const std::string& host, uint16_t port) {
+        return socket.Open(host, port);
+    }
+
+    uint16_t Port() const {
+        return socket.LocalPort();
+    }
+
+    size_t RoomCount() const {
+        return rooms.size();
+    }
+
+    int ThreadCount() const {
+        return pool.Size();
+    }
+
+    //  ,  running   false
+    void Run(const std::atomic<bool>& running) {
+        auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / TICK_RATE));
+        auto nextTick = std::chrono::steady_clock::now();
+
+        while (running) {
+            RunTick();
+
+            //       -    
+            nextTick += period;
+            auto now = std::chrono::steady_clock::now();
+            if (now > nextTick + period * 4) nextTick = now;
+            std::this_thread::sleep_until(nextTick);
+        }
+    }
+
+    void RunTick() {
+        auto start = std::chrono::steady_clock::now();
+        double now = Seconds(start);
+        float deltaTime = 1.0f / TICK_RATE;
+
+        ReceivePackets(now);
+        if (++tickCount % static_cast<uint64_t>(TICK_RATE) == 0) DropSilentClients(now);
+
+        size_t grain = std::max<size_t>(1, rooms.size() / (pool.Size() * 8));
+        pool.ParallelFor(rooms.size(), grain, [this, deltaTime](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                Room& room = *rooms[i];
+                if (room.ConnectedCount() == 0) continue;
+
+                auto roomStart = std::chrono::steady_clock::now();
+                room.Step(deltaTime);
+                room.SendStates(socket, packetsSent, bytesSent);
+                roomStepTime.Record(Nanoseconds(roomStart, std::chrono::steady_clock::now()));
+            }
+        });
+
+        tickTime.Record(Nanoseconds(start, std::chrono::steady_clock::now()));
+    }
+
+private:
+    struct ClientRef {
+        int room;
+        int slot;
+    };
+
+    const Level& level;
+    ThreadPool pool;
+    UdpSocket socket;
+    std::vector<std::unique_ptr<Room>> rooms;
+    std::unordered_map<uint32_t, ClientRef> clients;
+    std::chrono::steady_clock::time_point startTime;
+    uint64_t tickCount = 0;
+
+    double Seconds(std::chrono::steady_clock::time_point time) const {
+        return std::chrono::duration<double>(time - startTime).count();
+    }
+
+    static uint64_t Nanoseconds(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    void ReceivePackets(double now) {
+        uint8_t buffer[MAX_PACKET_SIZE];
+        sockaddr_in from;
+        int size;
+        while ((size = socket.ReceiveFrom(buffer, sizeof(buffer), from)) > 0) {
+            packetsReceived.Add(1);
+            HandlePacket(buffer, static_cast<size_t>(size), from, now);
+        }
+    }
+
+    void HandlePacket(const uint8_t* data, size_t size, const sockaddr_in& from, double now) {
+        PacketReader in(data, size);
+        uint8_t type;
+        uint32_t clientId;
+        if (!ReadPacketHeader(in, type, clientId)) return;
+
+        auto client = clients.find(clientId);
+
+        if (type == PACKET_HELLO) {
+            uint16_t roomId = in.ReadU16();
+            if (in.failed) return;
+
+            //  HELLO ( WELCOME)   ,     
+            //     ;  - REJECT
+            bool accepted = false;
+            if (client == clients.end()) {
+                if (roomId < rooms.size()) {
+                    int slot = rooms[roomId]->Join(clientId, from, now);
+                    if (slot >= 0) {
+                        client = clients.emplace(clientId, ClientRef{ roomId, slot }).first;
+                        accepted = true;
+                    }
+                }
+            }
+            else {
+                const Room& room = *rooms[client->second.room];
+                accepted = client->second.room == roomId && SameAddress(room.slots[client->second.slot].address, from);
+            }
+
+            PacketWriter reply;
+            if (accepted) {
+                const Room& room = *rooms[client->second.room];
+                reply.WriteU8(PACKET_WELCOME);
+                reply.WriteU32(clientId);
+                reply.WriteU16(static_cast<uint16_t>(room.id));
+                reply.WriteU8(static_cast<uint8_t>(client->second.slot));
+                reply.WriteU8(static_cast<uint8_t>(room.layout.maxPlayers));
+                reply.WriteU16(static_cast<uint16_t>(room.layout.enemyCount));
+                reply.WriteU16(static_cast<uint16_t>(room.layout.coinCount));
+            }
+            else {
+                reply.WriteU8(PACKET_REJECT);
+                reply.WriteU32(clientId);
+            }
+            socket.SendTo(reply.data, reply.size, from);
+            return;
+        }
+
+        //    ,    HELLO:  clientId  
+        if (client == clients.end()) return;
+        Room& room = *rooms[client->second.room];
+        if (!SameAddress(room.slots[client->second.slot].address, from)) return;
+
+        if (type == PACKET_INPUT) {
+            uint32_t sequence = in.ReadU32();
+            uint32_t ackTick = in.ReadU32();
+            uint8_t buttons = in.ReadU8();
+            if (!in.failed) room.ApplyInput(client->second.slot, sequence, ackTick, buttons, now);
+        }
+        else if (type == PACKET_LEAVE) {
+            room.Leave(client->second.slot);
+            clients.erase(client);
+        }
+    }
+
+    void DropSilentClients(double now) {
+        for (auto client = clients.begin(); client != clients.end();) {
+            Room& room = *rooms[client->second.room];
+            if (now - room.slots[client->second.slot].lastHeard > CLIENT_TIMEOUT) {
+                room.Leave(client->second.slot);
+                client = clients.erase(client);
+            }
+            else {
+                ++client;
+            }
+        }
+    }
+};
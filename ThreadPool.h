@@ -0,0 +1,128 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//      ParallelFor.
+//    ,        .
+class ThreadPool {
+public:
+    ThreadPool(int workerCount) {
+        generation = 0;
+        chunkCount = 0;
+        chunkSize = 0;
+        itemCount = 0;
+        stopping = false;
+        for (int i = 0; i < workerCount; i++) {
+            workers.emplace_back([this]() { WorkerLoop(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeWorkers.notify_all();
+        for (auto& worker : workers) worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    //  ,  
+    int Size() const {
+        return static_cast<int>(workers.size()) + 1;
+    }
+
+    //  [0, count)    grain   ,    .
+    //     ,    0   .
+    void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& job) {
+        if (count == 0) return;
+        grain = std::max<size_t>(grain, 1);
+
+        size_t chunks = (count + grain - 1) / grain;
+        if (workers.empty() || chunks == 1) {
+            job(0, count);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            currentJob = &job;
+            itemCount = count;
+            chunkSize = grain;
+            chunkCount = chunks;
+            nextChunk = 0;
+            finishedChunks = 0;
+            generation++;
+        }
+        wakeWorkers.notify_all();
+
+        RunChunks();
+
+        //   ,   :       
+        std::unique_lock<std::mutex> lock(mutex);
+        jobDone.wait(lock, [this]() { return finishedChunks == chunkCount && busyWorkers == 0; });
+        currentJob = nullptr;
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeWorkers;
+    std::condition_variable jobDone;
+    const std::function<void(size_t, size_t)>* currentJob = nullptr;
+    size_t itemCount;
+    size_t chunkSize;
+    size_t chunkCount;
+    std::atomic<size_t> nextChunk{ 0 };
+    size_t finishedChunks = 0;
+    int busyWorkers = 0;
+    unsigned generation;
+    bool stopping;
+
+    void RunChunks() {
+        size_t done = 0;
+        for (;;) {
+            size_t chunk = nextChunk.fetch_add(1);
+            if (chunk >= chunkCount) break;
+
+            size_t begin = chunk * chunkSize;
+            size_t end = std::min(begin + chunkSize, itemCount);
+            (*currentJob)(begin, end);
+            done++;
+        }
+
+        if (done > 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            finishedChunks += done;
+        }
+    }
+
+    void WorkerLoop() {
+        unsigned seenGeneration = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wakeWorkers.wait(lock, [&]() {
+                    return stopping || (currentJob != nullptr && generation != seenGeneration);
+                });
+                if (stopping) return;
+                seenGeneration = generation;
+                busyWorkers++;
+            }
+
+            RunChunks();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            busyWorkers--;
+            if (busyWorkers == 0 && finishedChunks == chunkCount) jobDone.notify_one();
+        }
+    }
+};
@@ -0,0 +1,285 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+//          
+struct LodStats {
+    size_t nearUpdated = 0;     // ,  
+    size_t farUpdated = 0;      // ,   FAR_INTERVAL 
+    size_t farDeferred = 0;     //         
+    size_t frozenChecked = 0;   // ,     
+    size_t promoted = 0;        //     ,    
+    size_t frozen = 0;          //   FROZEN_RADIUS
+    double elapsedUs = 0.0;
+};
+
+//      (LOD).
+//     ,  -   FAR_INTERVAL ,
+//  FROZEN_RADIUS -  ,       FROZEN_INTERVAL .
+//         .     
+// (    ),        ,
+//      ,    .      .
+//      :   ,  
+//   ,       .
+//     ,     (, , ),
+//     ,       
+//   NEAR_RADIUS ( ).    -   :
+//     ,     .
+// ,      update ( PROMOTE_MARGIN   ).
+class UpdateScheduler {
+public:
+    float NEAR_RADIUS = 600.0f;
+    float FROZEN_RADIUS = 2000.0f;
+    int FAR_INTERVAL = 4;
+    int FROZEN_INTERVAL = 16;
+    double BUDGET_US = 1000.0;
+    size_t MIN_FAR_UPDATES = 16;  //       
+    float PROMOTE_MARGIN = 16.0f; //      update ( )
+    float PROMOTE_STEP = 32.0f;   //     
+    int PROMOTE_SLOTS = 64;       //           
+
+    //     ;  Run    
+    void Clear() {
+        tiers.clear();
+    }
+
+    // position(i) -> SDL_FPoint, update(i, deltaTime)     
+    template <class PositionFunction, class UpdateFunction>
+    void Run(size_t count, SDL_FPoint focus, float deltaTime, PositionFunction position, UpdateFunction update) {
+        //        
+        if (tiers.size() != count) Reset(count, focus, position);
+        auto start = std::chrono::steady_clock::now();
+
+        stats = LodStats();
+        time += deltaTime;
+        frame++;
+
+        // ,     ,  ;     .
+        //      ,       Run
+        float focusDx = focus.x - lastFocus.x;
+        float focusDy = focus.y - lastFocus.y;
+        focusTravel += std::sqrt(static_cast<double>(focusDx * focusDx + focusDy * focusDy));
+        lastFocus = focus;
+        uint32_t travelSlot = TravelSlot(focusTravel);
+        if (travelSlot - openPromoteSlot >= promoteRing.size() / 2) {
+            //    (, ):    ,   
+            for (std::vector<uint32_t>& slot : promoteRing) slot.clear();
+            promoteOverflow.clear();
+            promoteSlot.assign(count, NO_SLOT);
+            openPromoteSlot = travelSlot;
+            overflowCheckSlot = travelSlot + static_cast<uint32_t>(promoteRing.size() / 2);
+            for (size_t i = 0; i < count; i++) {
+                uint32_t index = static_cast<uint32_t>(i);
+                if (tiers[index] == TIER_NEAR) continue;
+                if (Classify(index, position(index), focus) == TIER_NEAR) stats.promoted++;
+            }
+        }
+        for (uint32_t slot = openPromoteSlot; slot <= travelSlot; slot++) {
+            promoteScratch.clear();
+            promoteScratch.swap(promoteRing[slot % promoteRing.size()]);
+            for (uint32_t index : promoteScratch) {
+                if (promoteSlot[index] != slot) continue;  //     
+                promoteSlot[index] = NO_SLOT;
+                if (tiers[index] == TIER_NEAR) continue;
+                if (Classify(index, position(index), focus) == TIER_NEAR) stats.promoted++;
+            }
+        }
+        openPromoteSlot = travelSlot;
+
+        //      ,    
+        if (travelSlot >= overflowCheckSlot) {
+            size_t kept = 0;
+            for (uint32_t index : promoteOverflow) {
+                uint32_t slot = promoteSlot[index];
+                if (slot == NO_SLOT || slot < travelSlot) continue;  //    
+                if (slot < travelSlot + promoteRing.size()) promoteRing[slot % promoteRing.size()].push_back(index);
+                else promoteOverflow[kept++] = index;
+            }
+            promoteOverflow.resize(kept);
+            overflowCheckSlot = travelSlot + static_cast<uint32_t>(promoteRing.size() / 2);
+        }
+
+        //   ;  ,   
+        nearIndices.swap(previousNear);
+        nearIndices.clear();
+        for (uint32_t index : previousNear) {
+            update(index, static_cast<float>(time - lastUpdate[index]));
+            lastUpdate[index] = time;
+            stats.nearUpdated++;
+            Classify(index, position(index), focus);
+        }
+
+        //  :        
+        std::vector<uint32_t>& bucket = buckets[frame % buckets.size()];
+        queue.insert(queue.end(), bucket.begin(), bucket.end());
+        bucket.clear();
+
+        double budgetUs = std::max(BUDGET_US - debtUs, 0.0);
+        size_t head = 0;
+        size_t work = 0;
+        for (; head < queue.size(); head++) {
+            if (work >= MIN_FAR_UPDATES && work % 16 == 0 && ElapsedUs(start) > budgetUs) break;
+
+            uint32_t index = queue[head];
+            scheduled[index] = 0;
+            if (tiers[index] == TIER_NEAR) continue;  //  ,   
+
+            uint8_t tier = Tier(position(index), focus);
+            if (tier == TIER_FROZEN) {
+                lastUpdate[index] = time;  //    
+                stats.frozenChecked++;
+            }
+            else {
+                update(index, static_cast<float>(time - lastUpdate[index]));
+                lastUpdate[index] = time;
+                stats.farUpdated++;
+            }
+            Classify(index, position(index), focus);
+            work++;
+        }
+        queue.erase(queue.begin(), queue.begin() + head);
+
+        stats.farDeferred = queue.size();
+        stats.frozen = frozenCount;
+        stats.elapsedUs = ElapsedUs(start);
+        debtUs = std::clamp(stats.elapsedUs - budgetUs, 0.0, BUDGET_US);
+    }
+
+    const LodStats& GetStats() const {
+        return stats;
+    }
+
+    //     Run:     
+    const std::vector<uint32_t>& NearIndices() const {
+        return nearIndices;
+    }
+
+private:
+    enum : uint8_t {
+        TIER_NEAR,
+        TIER_FAR,
+        TIER_FROZEN
+    };
+
+    std::vector<uint8_t> tiers;
+    std::vector<double> lastUpdate;          //     
+    std::vector<uint32_t> nearIndices;
+    std::vector<uint32_t> previousNear;
+    std::vector<std::vector<uint32_t>> buckets;
+    std::vector<uint32_t> queue;
+    std::vector<uint8_t> scheduled;          // 1 -       
+    static constexpr uint32_t NO_SLOT = UINT32_MAX;
+    std::vector<std::vector<uint32_t>> promoteRing;
+    std::vector<uint32_t> promoteScratch;
+    std::vector<uint32_t> promoteOverflow;   //   
+    uint32_t overflowCheckSlot = 0;
+    std::vector<uint32_t> promoteSlot;       //        NO_SLOT
+    uint32_t openPromoteSlot = 0;
+    double focusTravel = 0.0;                //   
+    SDL_FPoint lastFocus = { 0.0f, 0.0f };
+    double time = 0.0;
+    uint64_t frame = 0;
+    double debtUs = 0.0;
+    size_t frozenCount = 0;
+    LodStats stats;
+
+    static double ElapsedUs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    //   -    Clear    :
+    //       Run,     
+    template <class PositionFunction>
+    void Reset(size_t count, SDL_FPoint focus, PositionFunction position) {
+        //   FAR_INTERVAL,       
+        int farInterval = std::max(1, FAR_INTERVAL);
+        int slots = (std::max(farInterval, FROZEN_INTERVAL) + farInterval - 1) / farInterval * farInterval;
+        buckets.assign(slots, {});
+        tiers.assign(count, TIER_FAR);
+        lastUpdate.assign(count, time);
+        scheduled.assign(count, 0);
+        promoteRing.assign(std::max(PROMOTE_SLOTS, 3), {});
+        promoteSlot.assign(count, NO_SLOT);
+        promoteOverflow.clear();
+        openPromoteSlot = TravelSlot(focusTravel);
+        overflowCheckSlot = openPromoteSlot + static_cast<uint32_t>(promoteRing.size() / 2);
+        lastFocus = focus;
+        nearIndices.clear();
+        queue.clear();
+        debtUs = 0.0;
+        frozenCount = 0;
+
+        for (size_t i = 0; i < count; i++) {
+            Classify(static_cast<uint32_t>(i), position(i), focus);
+        }
+    }
+
+    uint32_t TravelSlot(double travel) const {
+        return static_cast<uint32_t>(travel / PROMOTE_STEP);
+    }
+
+    //    distance - NEAR_RADIUS      .
+    //  ,      :      
+    void SchedulePromotion(uint32_t index, float distanceSquared) {
+        //  :      -  ,  
+        if (promoteSlot[index] != NO_SLOT) {
+            double reach = promoteSlot[index] * static_cast<double>(PROMOTE_STEP) - focusTravel + NEAR_RADIUS + PROMOTE_MARGIN;
+            if (reach <= 0.0 || distanceSquared >= reach * reach) return;
+        }
+
+        double slack = std::sqrt(static_cast<double>(distanceSquared)) - NEAR_RADIUS - PROMOTE_MARGIN;
+        uint32_t slot = TravelSlot(focusTravel + std::max(slack, 0.0));
+        if (slot >= promoteSlot[index]) return;
+
+        promoteSlot[index] = slot;
+        if (slot < openPromoteSlot + promoteRing.size()) promoteRing[slot % promoteRing.size()].push_back(index);
+        else promoteOverflow.push_back(index);
+    }
+
+    static float DistanceSquared(SDL_FPoint point, SDL_FPoint focus) {
+        float dx = point.x - focus.x;
+        float dy = point.y - focus.y;
+        return dx * dx + dy * dy;
+    }
+
+    uint8_t Tier(float distanceSquared) const {
+        if (distanceSquared <= NEAR_RADIUS * NEAR_RADIUS) return TIER_NEAR;
+        return distanceSquared <= FROZEN_RADIUS * FROZEN_RADIUS ? TIER_FAR : TIER_FROZEN;
+    }
+
+    uint8_t Tier(SDL_FPoint point, SDL_FPoint focus) const {
+        return Tier(DistanceSquared(point, focus));
+    }
+
+    //   ,      ,    
+    uint8_t Classify(uint32_t index, SDL_FPoint point, SDL_FPoint focus) {
+        float distanceSquared = DistanceSquared(point, focus);
+        uint8_t tier = Tier(distanceSquared);
+        if (tiers[index] == TIER_FROZEN) frozenCount--;
+        if (tier == TIER_FROZEN) frozenCount++;
+        tiers[index] = tier;
+
+        if (tier == TIER_NEAR) {
+            nearIndices.push_back(index);
+            return tier;
+        }
+        SchedulePromotion(index, distanceSquared);
+
+        //          -    
+        if (scheduled[index]) return tier;
+        scheduled[index] = 1;
+
+        //    ,     
+        uint64_t slots = buckets.size();
+        uint64_t interval = tier == TIER_FAR ? static_cast<uint64_t>(std::max(1, FAR_INTERVAL)) : slots;
+        uint64_t phase = index % slots % interval;
+        uint64_t delay = (phase + interval - frame % interval) % interval;
+        if (delay == 0) delay = interval;
+        buckets[(frame + delay) % slots].push_back(index);
+        return tier;
+    }
+};